@@ -0,0 +1,168 @@
+/**
+ * @file interpreter_bench.cpp
+ * @brief Microbenchmarks for Instruction::execute: ns/op, allocations/op and bytes/op
+ * for every opcode and for mixed programs at several FOR_LOOP nesting levels.
+ *
+ * Separate executable (it has its own main), built from the repository root:
+ *   cl /O2 /std:c++17 /EHsc /I. benchmarks\interpreter_bench.cpp
+ * Usage: interpreter_bench [--min-time-ms N] [--seed N]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "../scheduler.h"
+
+using namespace std;
+
+/* ========== ALLOCATION COUNTING ========== */
+// Every operator new in this program goes through here; counts are only kept
+// while a measurement is running.
+static bool countingAllocations = false;
+static uint64_t allocationCount = 0;
+static uint64_t allocationBytes = 0;
+
+void* operator new(size_t size) {
+    if (countingAllocations) {
+        allocationCount++;
+        allocationBytes += size;
+    }
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) throw bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+/* ========== BENCHMARK HARNESS ========== */
+struct BenchResult {
+    string name;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+    uint64_t ops = 0;
+};
+
+const size_t batch_size = 1000;       // instructions per process per batch
+const size_t process_memory = 4096;   // same as the default mem-per-proc
+
+// Runs `program` (one opcode per entry, fresh process per batch) until at least
+// minTimeMs of measured time has passed. forLoopDepth is the depth the process
+// starts at: FOR_LOOP can nest until depth 3, so starting at 2 allows one level,
+// at 0 three levels.
+BenchResult runBenchmark(const string& name, const vector<InstructionType>& program, int forLoopDepth,
+    double minTimeMs, unsigned seed) {
+    srand(seed);
+    MemoryManager memory;
+    memory.configure(process_memory * 2, 16, process_memory, false, "fifo");
+
+    BenchResult result;
+    result.name = name;
+    double elapsedNs = 0.0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+    int pid = 0;
+
+    while (elapsedNs < minTimeMs * 1e6) {
+        // Setup is not measured
+        Process proc("bench", pid);
+        for (size_t i = 0; i < batch_size; ++i) {
+            proc.addInstruction(Instruction(program[i % program.size()]));
+        }
+        memory.allocate(pid, process_memory);
+        proc.attachMemory(&memory, process_memory);
+
+        allocationCount = 0;
+        allocationBytes = 0;
+        countingAllocations = true;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < batch_size; ++i) {
+            proc.forLoopDepth = forLoopDepth;
+            proc.quantumLeft = 1 << 30; // SLEEP never gets preempted
+            proc.sleepCounter = 0;
+            proc.executeNextInstruction(0);
+        }
+        auto end = chrono::steady_clock::now();
+        countingAllocations = false;
+
+        elapsedNs += chrono::duration<double, nano>(end - start).count();
+        allocs += allocationCount;
+        bytes += allocationBytes;
+        result.ops += batch_size;
+        memory.release(pid);
+        pid++;
+    }
+
+    result.nsPerOp = elapsedNs / result.ops;
+    result.allocsPerOp = double(allocs) / result.ops;
+    result.bytesPerOp = double(bytes) / result.ops;
+    return result;
+}
+
+// Uniform random opcodes, like CPUScheduler::populateInstructions
+vector<InstructionType> mixedProgram(unsigned seed) {
+    srand(seed);
+    vector<InstructionType> program(batch_size);
+    for (auto& type : program) {
+        type = static_cast<InstructionType>(rand() % 6);
+    }
+    return program;
+}
+
+void printReport(const vector<BenchResult>& results, double minTimeMs, unsigned seed) {
+    // Stable format: a versioned header, then one fixed-width line per benchmark in a fixed order
+    cout << "# csopesy-interpreter-bench v1 seed=" << seed << " min-time-ms=" << minTimeMs
+        << " batch=" << batch_size << endl;
+    cout << left << setw(28) << "benchmark" << right << setw(14) << "ns/op" << setw(14) << "allocs/op"
+        << setw(14) << "bytes/op" << setw(12) << "ops" << endl;
+    cout << fixed;
+    for (const BenchResult& r : results) {
+        cout << left << setw(28) << r.name << right
+            << setw(14) << setprecision(1) << r.nsPerOp
+            << setw(14) << setprecision(3) << r.allocsPerOp
+            << setw(14) << setprecision(1) << r.bytesPerOp
+            << setw(12) << r.ops << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double minTimeMs = 200.0;
+    unsigned seed = 12345;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string arg = argv[i];
+        if (arg == "--min-time-ms") minTimeMs = stod(argv[i + 1]);
+        else if (arg == "--seed") seed = static_cast<unsigned>(stoul(argv[i + 1]));
+    }
+
+    static const char* opcodeNames[] = { "PRINT", "DECLARE", "ADD", "SUBTRACT", "SLEEP", "FOR_LOOP" };
+    vector<BenchResult> results;
+    for (int op = PRINT; op <= FOR_LOOP; ++op) {
+        InstructionType type = static_cast<InstructionType>(op);
+        if (type == FOR_LOOP) {
+            for (int levels = 1; levels <= 3; ++levels) {
+                results.push_back(runBenchmark("opcode/FOR_LOOP/depth=" + to_string(levels), { type },
+                    3 - levels, minTimeMs, seed));
+            }
+        }
+        else {
+            results.push_back(runBenchmark(string("opcode/") + opcodeNames[op], { type }, 0, minTimeMs, seed));
+        }
+    }
+    vector<InstructionType> mixed = mixedProgram(seed);
+    for (int levels = 1; levels <= 3; ++levels) {
+        results.push_back(runBenchmark("mixed/depth=" + to_string(levels), mixed, 3 - levels, minTimeMs, seed));
+    }
+
+    printReport(results, minTimeMs, seed);
+    return 0;
+}
@@ -1,23 +1,138 @@
 #include "console.h"
 #include <ctime>
 #include <fstream>
+#include <iomanip>
+#include <thread>
+#include "gzip.h"
+#include <windows.h>
+#include <conio.h>
 
 using namespace std;
 
+/* Live screen view constants */
+const int screen_view_refresh_delay = 100; // ms between frames
+const size_t screen_view_log_lines = 10;   // output log lines shown at the bottom
+
+/* Report constants */
+const size_t report_chunk_records = 16384;  // records formatted per worker task
+const size_t report_buffer_bytes = 1 << 20; // stream buffer in front of the report file
+const char* const report_separator = "--------------------------------------\n";
+
 void Console::DrawScreen(const string& name) {
     Clear();
-    cout << "[Screen for: " << name << "]" << endl;
-    cout << "Process Name: " << name << endl;
-    cout << "Instruction Line: 532 / 1240" << endl;
-    cout << "Created At: " << screens[name] << endl;
-    cout << "CPU Cycles: " << scheduler.getCpuCycles() << endl;
-    cout << "-------------------------------" << endl;
+    WatchScreen(name);
+}
+
+// Builds one frame of the screen view from the live process state.
+// The frame always has the same number of lines so rows can be diffed in place.
+vector<string> Console::BuildScreenFrame(const string& name) {
+    vector<string> frame;
+    ProcessSnapshot snap;
+    if (!scheduler.getProcessSnapshot(name, snap, screen_view_log_lines)) {
+        frame.push_back("Process Name: " + name + " (not found in scheduler)");
+        frame.push_back("Created At: " + screens[name]);
+        frame.push_back("CPU Cycles: " + to_string(scheduler.getCpuCycles()));
+        frame.push_back("-------------------------------");
+        return frame;
+    }
+
+    frame.push_back("Process Name: " + snap.name + " (PID " + to_string(snap.pid) + ")");
+    frame.push_back("Instruction Line: " + to_string(snap.currentInstruction) + " / " + to_string(snap.totalInstructions));
+    if (snap.archived) frame.push_back("Core: N/A (Finished, archived)");
+    else if (snap.isFinished) frame.push_back("Core: N/A (Finished!)");
+    else if (snap.coreId < 0) frame.push_back("Core: N/A (waiting)");
+    else frame.push_back("Core: " + to_string(snap.coreId));
+    frame.push_back("Created At: " + snap.createdAt);
+    frame.push_back("CPU Cycles: " + to_string(scheduler.getCpuCycles()));
+    frame.push_back("---------- Output (" + to_string(snap.logSize) + " lines) ----------");
+    for (size_t i = 0; i < screen_view_log_lines; ++i) {
+        frame.push_back(i < snap.logTail.size() ? snap.logTail[i] : "");
+    }
+    frame.push_back("-------------------------------");
+    return frame;
+}
+
+// Live view of the process, refreshed until a key is pressed.
+// The view is drawn into its own console screen buffer, so scheduler and core
+// messages printed meanwhile go to the normal buffer and can't scroll it; they
+// are there when the view closes. Only rows that differ from the previous frame
+// are rewritten.
+void Console::WatchScreen(const string& name) {
+    HANDLE view = CreateConsoleScreenBuffer(GENERIC_READ | GENERIC_WRITE, 0, nullptr, CONSOLE_TEXTMODE_BUFFER, nullptr);
+    if (view == INVALID_HANDLE_VALUE) {
+        // No console to draw into (e.g. output redirected): print a single frame
+        for (const string& line : BuildScreenFrame(name)) cout << line << endl;
+        return;
+    }
+    CONSOLE_CURSOR_INFO cursor = { 1, FALSE };
+    SetConsoleCursorInfo(view, &cursor);
+    SetConsoleActiveScreenBuffer(view);
+
+    auto drawRow = [view](int row, const string& text) {
+        DWORD written;
+        WriteConsoleOutputCharacterA(view, text.c_str(), static_cast<DWORD>(text.size()), { 0, static_cast<SHORT>(row) }, &written);
+    };
+    drawRow(0, "[Screen for: " + name + "] (press any key for the command prompt)");
+
+    vector<string> lastFrame;
+    while (true) {
+        vector<string> frame = BuildScreenFrame(name);
+        size_t rows = max(frame.size(), lastFrame.size());
+        for (size_t i = 0; i < rows; ++i) {
+            string line = i < frame.size() ? frame[i] : "";
+            const string previous = i < lastFrame.size() ? lastFrame[i] : "";
+            if (i < lastFrame.size() && line == previous) continue;
+            if (previous.size() > line.size()) line += string(previous.size() - line.size(), ' ');
+            drawRow(static_cast<int>(i) + 1, line);
+        }
+        lastFrame = frame;
+
+        if (_kbhit()) {
+            _getch();
+            break;
+        }
+        this_thread::sleep_for(chrono::milliseconds(screen_view_refresh_delay));
+    }
+    SetConsoleActiveScreenBuffer(GetStdHandle(STD_OUTPUT_HANDLE));
+    CloseHandle(view);
+    for (const string& line : lastFrame) cout << line << endl; // leave the last frame above the prompt
 }
 
 void Console::ProcessSmi() {
-    cout << "process-smi command recognized. Displaying stats..." << endl;
-    cout << "[CPU Usage: 34%] [Memory Usage: 128MB] [Disk I/O: 2.4MB/s]" << endl;
+    MemoryStats mem = scheduler.getMemoryStats();
+    int cores = scheduler.config.numCpu;
+    int busy = scheduler.getActiveCores();
+    size_t memPercent = mem.totalBytes > 0 ? (mem.usedFrames * mem.frameSize * 100) / mem.totalBytes : 0;
+
+    cout << "-------------------------------" << endl;
+    cout << "[CPU Usage: " << (cores > 0 ? busy * 100 / cores : 0) << "%] [Cores Used: " << busy << " / " << cores << "]" << endl;
+    cout << "[Memory Usage: " << mem.usedFrames * mem.frameSize << " / " << mem.totalBytes << " bytes (" << memPercent << "%)]"
+        << " [Frames: " << mem.usedFrames << " / " << mem.totalFrames << " x " << mem.frameSize << " bytes]" << endl;
+    cout << "[Fragmentation: internal " << mem.internalFragmentation << " bytes, external "
+        << mem.externalFragmentation << " bytes]" << endl;
+    cout << "[Processes in memory: " << mem.residentProcesses << "] [Waiting for memory: "
+        << scheduler.getDeferredCount() << "]" << endl;
+    ReadyQueueStats queue = scheduler.getReadyQueueStats();
+    cout << "[Ready Queue: " << queue.depth << " / ";
+    if (scheduler.config.readyQueueCapacity > 0) cout << scheduler.config.readyQueueCapacity;
+    else cout << "unbounded";
+    cout << " (" << scheduler.config.readyQueuePolicy << "), peak " << queue.peakDepth
+        << ", pending " << queue.pendingDepth << "]" << endl;
+    cout << "[Admitted: " << queue.admitted << " (" << queue.admissionRate << "/s)] [Dropped: " << queue.dropped
+        << "] [Backpressure ticks: " << queue.backpressureTicks << "]" << endl;
+    cout << "[Time in queue: avg " << (queue.dispatched > 0 ? queue.totalWaitMs / queue.dispatched : 0.0)
+        << " ms, max " << queue.maxWaitMs << " ms]" << endl;
+    if (scheduler.hasSubmissionRing()) {
+        cout << "[Ring Submissions: " << scheduler.getSubmissionsAccepted() << " accepted, "
+            << scheduler.getSubmissionsRejected() << " rejected]" << endl;
+    }
+    cout << "[Instructions Retired: " << scheduler.getInstructionsRetired() << " ("
+        << scheduler.getInstructionRate() << "/s)]" << endl;
     cout << "[CPU Cycles: " << scheduler.getCpuCycles() << "]" << endl;
+    cout << "-------------------------------" << endl;
+    for (const auto& [pid, name] : scheduler.getResidentProcesses()) {
+        cout << "  " << name << " (PID " << pid << ")" << endl;
+    }
 }
 
 void Console::ScreenSession(const string& name) {
@@ -66,22 +181,24 @@ bool Console::IsInitialized() {
     return initialized;
 }
 
+void Console::SetInteractive(bool value) {
+    interactive = value;
+}
+
 void Console::CreateScreen(const string& name) {
     if (!initialized) {
         cout << "[ERROR] Please initialize the system first using 'initialize'.\n";
         return;
     }
 
-    if (scheduler.findProcess(name)) {
+    // Add the process to the scheduler; the name check and insert happen under one lock
+    if (!scheduler.addProcess(name)) {
         cout << "Process '" << name << "' already exists. Use 'screen -r " << name << "' to resume." << endl;
         return;
     }
 
-    // Add the process to the scheduler
-    scheduler.addProcess(name);
-
     screens[name] = GetCurrentTimestamp();
-    ScreenSession(name);
+    if (interactive) ScreenSession(name);
 }
 
 void Console::ListScreens() {
@@ -112,9 +229,15 @@ void Console::ResumeScreen(const string& name) {
     if (!ScreenExists(name)) {
         cout << "Screen '" << name << "' does not exist. Use 'screen -s <name>' to create it." << endl;
     }
-    else {
+    else if (interactive) {
         ScreenSession(name);
     }
+    else {
+        cout << "[Screen for: " << name << "]" << endl;
+        for (const string& line : BuildScreenFrame(name)) {
+            cout << line << endl;
+        }
+    }
 }
 
 void Console::SchedulerStart() {
@@ -135,35 +258,137 @@ void Console::SchedulerStop() {
     scheduler.stopScheduler();
 }
 
-void Console::ReportUtil() {
+void Console::ReloadConfig() {
     if (!initialized) {
         cout << "[ERROR] Please initialize the system first using 'initialize'.\n";
         return;
     }
 
-    ofstream file("csopesy-log.txt");
+    scheduler.reloadConfig();
+}
+
+// Formats snaps[begin, end) into one block of the report. Runs on a worker
+// thread, so it only touches its own slice and its own output string.
+static string FormatReportChunk(const vector<ProcessSnapshot>& snaps, size_t begin, size_t end, bool compress) {
+    string text;
+    text.reserve((end - begin) * 128);
+    for (size_t i = begin; i < end; ++i) {
+        const ProcessSnapshot& p = snaps[i];
+        text += "PID: ";
+        text += to_string(p.pid);
+        text += "\nName: ";
+        text += p.name;
+        text += "\nCreated At: ";
+        text += p.createdAt;
+        text += p.isFinished ? "\nFinished: Yes" : "\nFinished: No";
+        text += "\nInstruction Progress: ";
+        text += to_string(p.currentInstruction);
+        text += " / ";
+        text += to_string(p.totalInstructions);
+        text += "\n";
+        text += report_separator;
+    }
+    return compress ? GzipWriter::compress(text) : text;
+}
+
+string Console::FormatReportHeader(bool incremental, size_t records) {
+    ostringstream header;
+    if (incremental) {
+        header << "[REPORT] Incremental update at " << GetCurrentTimestamp() << ": "
+            << records << " changed processes\n";
+    }
+    header << "[REPORT] CPU Cycles: " << scheduler.getCpuCycles() << "\n";
+    header << "[REPORT] Scheduler: " << (scheduler.config.scheduler == "rr" ? "Round Robin" : "FCFS") << "\n";
+    header << "[REPORT] Number of CPUs: " << scheduler.config.numCpu << "\n";
+    header << "[REPORT] Quantum Cycles: " << scheduler.config.quantumCycles << "\n";
+    header << "[REPORT] Instructions Retired: " << scheduler.getInstructionsRetired() << "\n";
+    MemoryStats mem = scheduler.getMemoryStats();
+    header << "[REPORT] Memory: " << mem.usedFrames << " / " << mem.totalFrames << " frames used ("
+        << mem.frameSize << " bytes per frame)\n";
+    if (mem.demandPaging) {
+        header << "[REPORT] Demand Paging: on (" << mem.replacementPolicy << ")\n";
+        header << "[REPORT] Page Faults: " << mem.pageFaults << "\n";
+        header << "[REPORT] Pages In: " << mem.pageIns << "\n";
+        header << "[REPORT] Pages Out: " << mem.pageOuts << "\n";
+    }
+    else {
+        header << "[REPORT] Demand Paging: off\n";
+    }
+    size_t spilled = scheduler.getSpilledCount();
+    if (spilled > 0) {
+        header << "[REPORT] Archived to " << scheduler.config.archiveFile << ": " << spilled << " processes\n";
+    }
+    header << report_separator;
+    return header.str();
+}
+
+void Console::ReportUtil(const string& mode) {
+    if (!initialized) {
+        cout << "[ERROR] Please initialize the system first using 'initialize'.\n";
+        return;
+    }
+    if (!mode.empty() && mode != "-i" && mode != "--incremental") {
+        cout << "[ERROR] Usage: report-util [-i | --incremental]\n";
+        return;
+    }
+
+    bool compress = scheduler.config.reportCompress;
+    string path = compress ? "csopesy-log.txt.gz" : "csopesy-log.txt";
+    // An incremental report appends to the previous one, so it needs one in the same format
+    bool incremental = !mode.empty() && lastReportPath == path;
+    if (!mode.empty() && !incremental) {
+        cout << "[REPORT] No previous " << path << " report this session; writing a full report.\n";
+    }
+
+    auto start = chrono::steady_clock::now();
+    ofstream file(path, ios::binary | (incremental ? ios::app : ios::trunc));
     if (!file.is_open()) {
-        cout << "[ERROR] Could not open csopesy-log.txt for writing.\n";
+        cout << "[ERROR] Could not open " << path << " for writing.\n";
         return;
     }
+    // One large buffer in front of the file. MSVC's filebuf only accepts it once
+    // the file is open, and before the first write.
+    vector<char> buffer(report_buffer_bytes);
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    vector<ProcessSnapshot> snaps = scheduler.getReportSnapshots(incremental);
 
-    file << "[REPORT] CPU Cycles: " << scheduler.getCpuCycles() << "\n";
-    file << "[REPORT] Scheduler: " << (scheduler.config.scheduler == "rr" ? "Round Robin" : "FCFS") << "\n";
-    file << "[REPORT] Number of CPUs: " << scheduler.config.numCpu << "\n";
-    file << "[REPORT] Quantum Cycles: " << scheduler.config.quantumCycles << "\n";
-    file << "--------------------------------------\n";
+    string header = FormatReportHeader(incremental, snaps.size());
+    if (compress) header = GzipWriter::compress(header);
+    file.write(header.data(), header.size());
 
-    const vector<Process>& all = scheduler.getAllProcesses();
-    for (const Process& p : all) {
-        file << "PID: " << p.pid << "\n";
-        file << "Name: " << p.name << "\n";
-        file << "Created At: " << p.createdAt << "\n";
-        file << "Finished: " << (p.isFinished ? "Yes" : "No") << "\n";
-        file << "Instruction Progress: "
-            << p.currentInstruction << " / " << p.instructions.size() << "\n";
-        file << "--------------------------------------\n";
+    // Each chunk is formatted (and compressed into its own gzip member) on a
+    // worker, then written in order as soon as it is ready
+    size_t chunks = (snaps.size() + report_chunk_records - 1) / report_chunk_records;
+    size_t workers = scheduler.config.reportWorkers > 0 ? scheduler.config.reportWorkers : thread::hardware_concurrency();
+    workers = max<size_t>(1, min(workers, chunks));
+    vector<string> formatted(chunks);
+    vector<thread> threads;
+    size_t nextChunk = 0;
+    auto launch = [&]() {
+        size_t begin = nextChunk * report_chunk_records;
+        size_t end = min(begin + report_chunk_records, snaps.size());
+        string& slot = formatted[nextChunk++];
+        threads.emplace_back([&snaps, &slot, begin, end, compress]() {
+            slot = FormatReportChunk(snaps, begin, end, compress);
+        });
+    };
+    while (nextChunk < workers && nextChunk < chunks) launch();
+    for (size_t i = 0; i < chunks; ++i) {
+        threads[i].join();
+        if (nextChunk < chunks) launch(); // keep the workers busy while this chunk is written
+        file.write(formatted[i].data(), formatted[i].size());
+        string().swap(formatted[i]);
     }
 
     file.close();
-    cout << "[REPORT] csopesy-log.txt created.\n";
+    if (file.fail()) {
+        // Nothing is marked as reported, so the next incremental report retries these processes
+        cout << "[ERROR] Could not write " << path << ".\n";
+        return;
+    }
+    scheduler.markReported(snaps);
+    lastReportPath = path;
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "[REPORT] " << path << (incremental ? " updated" : " created") << " (" << snaps.size()
+        << " processes, " << fixed << setprecision(1) << ms << " ms).\n" << defaultfloat;
 }
@@ -9,6 +9,7 @@
 #include <map>
 #include "scheduler.h"
 #include <set>
+#include <vector>
 
 using namespace std;
 
@@ -20,21 +21,28 @@ void Welcome();
 
 class Console {
     bool initialized = false;
+    bool interactive = true; // false in --script mode: screens are created without entering a session
     CPUScheduler scheduler;
     map<string, string> screens;
     set<string> activeScreens;
     void DrawScreen(const string& name);
-    void ProcessSmi();
+    vector<string> BuildScreenFrame(const string& name);
+    void WatchScreen(const string& name);
     void ScreenSession(const string& name);
     bool ScreenExists(const string& name);
+    string lastReportPath; // report-util output that an incremental report can append to
+    string FormatReportHeader(bool incremental, size_t records);
 
 public:
     void Initialize();
     bool IsInitialized();
+    void SetInteractive(bool value);
     void CreateScreen(const string& name);
     void ListScreens();
     void ResumeScreen(const string& name);
     void SchedulerStart();
     void SchedulerStop();
-    void ReportUtil();
+    void ReportUtil(const string& mode = "");
+    void ReloadConfig();
+    void ProcessSmi();
 };
\ No newline at end of file
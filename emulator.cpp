@@ -7,6 +7,14 @@
 #include <iostream>
 #include <string>
 #include <ctime>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include <windows.h>
 #include "console.h"
 #include "marquee.h"
@@ -49,34 +57,186 @@ void Clear() {
     Welcome();
 }
 
-int main() {
+/* ========== COMMAND DISPATCH ========== */
+using CommandHandler = function<void(const string& arg)>;
+
+// Splits a command line into its dispatch key and argument.
+// "screen -s P1" -> key "screen -s", arg "P1"; "wait 500" -> key "wait", arg "500"
+void ParseCommand(const string& command, string& key, string& arg) {
+    size_t start = command.find_first_not_of(' ');
+    if (start == string::npos) {
+        key = "";
+        arg = "";
+        return;
+    }
+    size_t end = command.find(' ', start);
+    key = command.substr(start, end == string::npos ? string::npos : end - start);
+    if (key == "screen" && end != string::npos) {
+        size_t flagStart = command.find_first_not_of(' ', end);
+        if (flagStart != string::npos && command[flagStart] == '-') {
+            end = command.find(' ', flagStart);
+            key += " " + command.substr(flagStart, end == string::npos ? string::npos : end - flagStart);
+        }
+    }
+    size_t argStart = (end == string::npos) ? string::npos : command.find_first_not_of(' ', end);
+    arg = (argStart == string::npos) ? "" : command.substr(argStart);
+}
+
+unordered_map<string, CommandHandler> BuildCommandTable(Console& console, bool& running) {
+    return {
+        { "initialize",      [&](const string&) { console.Initialize(); } },
+        { "screen -ls",      [&](const string&) { console.ListScreens(); } },
+        { "screen -s",       [&](const string& arg) {
+            if (arg.empty()) throw invalid_argument("Usage: screen -s <name>");
+            console.CreateScreen(arg);
+        } },
+        { "screen -r",       [&](const string& arg) {
+            if (arg.empty()) throw invalid_argument("Usage: screen -r <name>");
+            console.ResumeScreen(arg);
+        } },
+        { "scheduler-start", [&](const string&) { console.SchedulerStart(); } },
+        { "scheduler-stop",  [&](const string&) { console.SchedulerStop(); } },
+        { "report-util",     [&](const string& arg) { console.ReportUtil(arg); } },
+        { "process-smi",     [&](const string&) { console.ProcessSmi(); } },
+        { "reload-config",   [&](const string&) { console.ReloadConfig(); } },
+        { "marquee",         [&](const string&) {
+            StartMarqueeConsole();
+            Welcome(); // Show welcome screen again after exiting marquee
+        } },
+        { "wait",            [&](const string& arg) {
+            size_t parsed = 0;
+            int ms = 0;
+            try {
+                ms = arg.empty() ? 0 : stoi(arg, &parsed);
+            }
+            catch (const exception&) {
+                parsed = string::npos;
+            }
+            if ((!arg.empty() && parsed != arg.size()) || ms < 0) {
+                throw invalid_argument("Usage: wait <milliseconds>");
+            }
+            this_thread::sleep_for(chrono::milliseconds(ms));
+        } },
+        { "clear",           [&](const string&) { Clear(); } },
+        { "exit",            [&](const string&) { running = false; } },
+    };
+}
+
+// Runs one command through the table. Returns false if the command is unknown.
+bool DispatchCommand(unordered_map<string, CommandHandler>& commands, Console& console, const string& command) {
+    string key, arg;
+    ParseCommand(command, key, arg);
+    auto it = commands.find(key);
+    if (it == commands.end()) {
+        cout << "Unknown command. Please try again." << endl;
+        return false;
+    }
+    if (!console.IsInitialized() && key != "initialize" && key != "exit") {
+        cout << "Please initialize the system first using 'initialize' command." << endl;
+        return false;
+    }
+    it->second(arg);
+    return true;
+}
+
+/* ========== SCRIPT MODE ========== */
+// Executes a command script non-interactively (one command per line, '#' for comments)
+// and prints the latency of every command plus a summary at the end.
+int RunScript(const string& path) {
+    ifstream script(path);
+    if (!script.is_open()) {
+        cout << "[SCRIPT] Could not open script file: " << path << endl;
+        return 1;
+    }
+
+    Console console;
+    console.SetInteractive(false);
+    bool running = true;
+    unordered_map<string, CommandHandler> commands = BuildCommandTable(console, running);
+    commands.erase("marquee"); // needs a keyboard
+    commands.erase("clear");
+
+    struct CommandStats {
+        int count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+    unordered_map<string, CommandStats> stats;
+    vector<string> order;
+    int executed = 0;
+    int failed = 0;
+    int lineNumber = 0;
+    auto scriptStart = chrono::steady_clock::now();
+
+    string line;
+    while (running && getline(script, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t start = line.find_first_not_of(" \t");
+        if (start == string::npos || line[start] == '#') continue;
+        line = line.substr(start);
+
+        string key, arg;
+        ParseCommand(line, key, arg);
+
+        auto begin = chrono::steady_clock::now();
+        bool ok;
+        try {
+            ok = DispatchCommand(commands, console, line);
+        }
+        catch (const exception& e) {
+            cout << "[SCRIPT] Line " << lineNumber << ": " << e.what() << endl;
+            ok = false;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+        executed++;
+        if (!ok) failed++;
+        if (stats.find(key) == stats.end()) order.push_back(key);
+        CommandStats& s = stats[key];
+        s.count++;
+        s.totalMs += ms;
+        s.maxMs = max(s.maxMs, ms);
+
+        cout << "[SCRIPT] " << GetCurrentTimestamp() << " line " << lineNumber << ": '" << line
+            << "' " << (ok ? "ok" : "FAILED") << " (" << ms << " ms)" << endl;
+    }
+
+    double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - scriptStart).count();
+    cout << "[SCRIPT] -------- Summary --------" << endl;
+    cout << "[SCRIPT] Commands executed: " << executed << ", failed: " << failed
+        << ", total time: " << totalMs << " ms" << endl;
+    if (totalMs > 0) {
+        cout << "[SCRIPT] Throughput: " << (executed * 1000.0 / totalMs) << " commands/s" << endl;
+    }
+    for (const string& key : order) {
+        const CommandStats& s = stats[key];
+        cout << "[SCRIPT]   " << key << ": count " << s.count
+            << ", avg " << (s.totalMs / s.count) << " ms, max " << s.maxMs << " ms" << endl;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
     srand(static_cast<unsigned int>(time(nullptr)));
+    if (argc >= 3 && string(argv[1]) == "--script") {
+        return RunScript(argv[2]);
+    }
+
     Welcome();
     Console console;
     bool running = true;
+    unordered_map<string, CommandHandler> commands = BuildCommandTable(console, running);
     while (running) {
         string command;
         cout << "Enter command: ";
         getline(cin, command);
-        if (command == "initialize") console.Initialize();
-        else if (!console.IsInitialized() && command != "exit") {
-            cout << "Please initialize the system first using 'initialize' command." << endl;
-            // add a part where the config file will be loaded?? or smth here emememe
-            // ^reply to above: config file is read in Console class's initialize, with the Scheduler class's loadConfig method
+        try {
+            DispatchCommand(commands, console, command);
         }
-        else if (command == "screen -ls") console.ListScreens();
-        else if (command.rfind("screen -s ", 0) == 0) console.CreateScreen(command.substr(10));
-        else if (command.rfind("screen -r ", 0) == 0) console.ResumeScreen(command.substr(10));
-        else if (command == "scheduler-start") console.SchedulerStart();
-        else if (command == "scheduler-stop") console.SchedulerStop();
-        else if (command == "report-util") console.ReportUtil();
-        else if (command == "marquee") {
-            StartMarqueeConsole();
-            Welcome(); // Show welcome screen again after exiting marquee
+        catch (const exception& e) {
+            cout << "[ERROR] " << e.what() << endl;
         }
-        else if (command == "clear") Clear();
-        else if (command == "exit") running = false;
-        else cout << "Unknown command. Please try again." << endl;
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,168 @@
+/**
+ * @file gzip.h
+ * @brief This file contains a small dependency-free gzip (RFC 1952) compressor
+ *
+ * Each call produces one complete gzip member holding a single fixed-Huffman
+ * deflate block with LZ77 matching. Members can be concatenated (gunzip and
+ * zlib read them as one stream), so independent chunks can be compressed in
+ * parallel and appended to the same file.
+ */
+
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class GzipWriter {
+public:
+    static string compress(const string& input) {
+        GzipWriter writer;
+        writer.out.reserve(input.size() / 3 + 64);
+        static const uint8_t header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+        writer.out.append(reinterpret_cast<const char*>(header), sizeof(header));
+        writer.deflate(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+        writer.writeLE32(crc32(reinterpret_cast<const uint8_t*>(input.data()), input.size()));
+        writer.writeLE32(static_cast<uint32_t>(input.size()));
+        return writer.out;
+    }
+
+private:
+    static const int window_size = 32768;
+    static const int min_match = 3;
+    static const int max_match = 258;
+    static const int hash_bits = 15;
+    static const int max_chain = 8; // short chains: report text compresses nearly as well and twice as fast
+
+    string out;
+    uint32_t bitBuffer = 0;
+    int bitCount = 0;
+
+    static uint32_t crc32(const uint8_t* data, size_t size) {
+        // Function-local static: initialized once, thread-safely, by whichever worker gets here first
+        static const array<uint32_t, 256> table = []() {
+            array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    void writeLE32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    // Deflate packs bits LSB first
+    void writeBits(uint32_t value, int count) {
+        bitBuffer |= value << bitCount;
+        bitCount += count;
+        while (bitCount >= 8) {
+            out.push_back(static_cast<char>(bitBuffer & 0xFF));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    // Huffman codes are defined MSB first, so they are reversed before packing
+    void writeCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        writeBits(reversed, length);
+    }
+
+    void flushBits() {
+        if (bitCount > 0) out.push_back(static_cast<char>(bitBuffer & 0xFF));
+        bitBuffer = 0;
+        bitCount = 0;
+    }
+
+    // Fixed Huffman literal/length alphabet (RFC 1951 3.2.6)
+    void writeSymbol(int symbol) {
+        if (symbol < 144) writeCode(0x30 + symbol, 8);
+        else if (symbol < 256) writeCode(0x190 + (symbol - 144), 9);
+        else if (symbol < 280) writeCode(symbol - 256, 7);
+        else writeCode(0xC0 + (symbol - 280), 8);
+    }
+
+    void writeMatch(int length, int distance) {
+        static const int lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const int lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const int distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const int distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        int l = 28;
+        while (lengthBase[l] > length) l--;
+        writeSymbol(257 + l);
+        writeBits(length - lengthBase[l], lengthExtra[l]);
+
+        int d = 29;
+        while (distBase[d] > distance) d--;
+        writeCode(d, 5);
+        writeBits(distance - distBase[d], distExtra[d]);
+    }
+
+    static uint32_t hash3(const uint8_t* p) {
+        return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & ((1 << hash_bits) - 1);
+    }
+
+    void deflate(const uint8_t* data, size_t size) {
+        writeBits(1, 1); // BFINAL
+        writeBits(1, 2); // BTYPE = fixed Huffman
+
+        vector<int> head(1 << hash_bits, -1);
+        vector<int> prev(window_size, -1);
+        size_t pos = 0;
+        while (pos < size) {
+            int bestLength = 0;
+            int bestDistance = 0;
+            if (pos + min_match <= size) {
+                uint32_t h = hash3(data + pos);
+                int candidate = head[h];
+                int chain = max_chain;
+                size_t limit = size - pos < max_match ? size - pos : max_match;
+                while (candidate >= 0 && pos - candidate <= window_size && chain-- > 0) {
+                    size_t length = 0;
+                    while (length < limit && data[candidate + length] == data[pos + length]) length++;
+                    if (static_cast<int>(length) > bestLength) {
+                        bestLength = static_cast<int>(length);
+                        bestDistance = static_cast<int>(pos - candidate);
+                        if (length == limit) break;
+                    }
+                    candidate = prev[candidate % window_size];
+                }
+            }
+
+            size_t advance = 1;
+            if (bestLength >= min_match) {
+                writeMatch(bestLength, bestDistance);
+                advance = bestLength;
+            }
+            else {
+                writeSymbol(data[pos]);
+            }
+            for (size_t i = 0; i < advance; ++i, ++pos) {
+                if (pos + min_match <= size) {
+                    uint32_t h = hash3(data + pos);
+                    prev[pos % window_size] = head[h];
+                    head[h] = static_cast<int>(pos);
+                }
+            }
+        }
+        writeSymbol(256); // end of block
+        flushBits();
+    }
+};
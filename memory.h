@@ -0,0 +1,354 @@
+/**
+ * @file memory.h
+ * @brief This file contains the MemoryManager class definition (emulated main memory)
+ */
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <atomic>
+#include "paging.h"
+
+using namespace std;
+
+/* ========== MEMORY STATS ========== */
+struct MemoryStats {
+    size_t totalBytes = 0;
+    size_t usedBytes = 0;              // bytes requested by resident processes
+    size_t frameSize = 0;
+    size_t totalFrames = 0;
+    size_t usedFrames = 0;
+    size_t internalFragmentation = 0;  // allocated but unused bytes inside the last frame of each process
+    size_t externalFragmentation = 0;  // free bytes too small to admit one more process
+    int residentProcesses = 0;
+
+    // Demand paging
+    bool demandPaging = false;
+    string replacementPolicy;
+    uint64_t pageFaults = 0;
+    uint64_t pageIns = 0;
+    uint64_t pageOuts = 0;
+};
+
+// Counters readable without taking the memory manager's mutex
+struct MemoryCounters {
+    size_t frameSize = 0;
+    size_t totalFrames = 0;
+    size_t usedFrames = 0;
+    uint64_t pageFaults = 0;
+    uint64_t pageIns = 0;
+    uint64_t pageOuts = 0;
+};
+
+/* ========== MEMORY MANAGER ========== */
+// Emulated main memory split into fixed-size frames.
+// frameOwner/framePage form the frame table (owner pid or -1, and which of its
+// pages the frame holds), freeFrames is a stack of free frame indices so a
+// single frame is allocated or freed in O(1).
+//
+// Without demand paging a process gets all its frames on admission.
+// With demand paging it only gets a page table; pages are brought in on the
+// first read/write that touches them, evicting a victim chosen by the
+// replacement policy into the backing store when no frame is free.
+class MemoryManager {
+public:
+    void configure(size_t totalBytes, size_t frameBytes, size_t bytesPerProcess,
+        bool paging, const string& policyName) {
+        lock_guard<mutex> lock(memoryMutex);
+        frameSize = frameBytes >= 2 ? frameBytes & ~static_cast<size_t>(1) : 2; // keep uint16_t values inside one page
+        processSize = bytesPerProcess;
+        demandPaging = paging;
+        size_t numFrames = totalBytes / frameSize;
+        frameOwner.assign(numFrames, -1);
+        framePage.assign(numFrames, -1);
+        physicalMemory.assign(numFrames * frameSize, 0);
+        freeFrames.clear();
+        freeFrames.reserve(numFrames);
+        for (size_t i = numFrames; i > 0; --i) {
+            freeFrames.push_back(static_cast<int>(i - 1)); // lowest frame index on top
+        }
+        allocations.clear();
+        pageFaults = 0;
+        pageIns = 0;
+        pageOuts = 0;
+        usedFrameCount = 0;
+        totalFrameCount = numFrames;
+        frameSizeBytes = frameSize;
+
+        policy = makeReplacementPolicy(policyName);
+        policy->reset(numFrames);
+        if (demandPaging) {
+            backingStore.open("csopesy-backing-store.bin", frameSize, numFrames);
+        }
+        else {
+            backingStore.close();
+        }
+    }
+
+    size_t framesFor(size_t bytes) const {
+        return (bytes + frameSize - 1) / frameSize;
+    }
+
+    // Without demand paging, allocates every frame a process needs, or nothing
+    // if they don't all fit. With demand paging, only creates its page table.
+    bool allocate(int pid, size_t bytes) {
+        lock_guard<mutex> lock(memoryMutex);
+        size_t needed = framesFor(bytes);
+        if (allocations.count(pid) || (!demandPaging && needed > freeFrames.size())) {
+            return false;
+        }
+        Allocation& alloc = allocations[pid];
+        alloc.bytes = bytes;
+        if (demandPaging) {
+            alloc.pageTable.assign(needed, PageTableEntry());
+        }
+        else {
+            alloc.frames.reserve(needed);
+            for (size_t i = 0; i < needed; ++i) {
+                int frame = allocateFrame(pid);
+                framePage[frame] = static_cast<int>(i);
+                alloc.frames.push_back(frame);
+            }
+        }
+        return true;
+    }
+
+    void release(int pid) {
+        lock_guard<mutex> lock(memoryMutex);
+        auto it = allocations.find(pid);
+        if (it == allocations.end()) {
+            return;
+        }
+        for (int frame : it->second.frames) {
+            freeFrame(frame);
+        }
+        for (const PageTableEntry& entry : it->second.pageTable) {
+            if (entry.frame >= 0) {
+                policy->onFree(entry.frame);
+                freeFrame(entry.frame);
+            }
+            if (entry.slot >= 0) {
+                backingStore.freeSlot(entry.slot);
+            }
+        }
+        allocations.erase(it);
+    }
+
+    bool isResident(int pid) const {
+        lock_guard<mutex> lock(memoryMutex);
+        return allocations.count(pid) > 0;
+    }
+
+    bool canEverFit(size_t bytes) const {
+        lock_guard<mutex> lock(memoryMutex);
+        return demandPaging || framesFor(bytes) <= frameOwner.size();
+    }
+
+    // Without demand paging a resident process's frames never move until it is
+    // released, so it can resolve them once and then reach its memory without
+    // taking memoryMutex. Returns the frame base pointers in page order, or
+    // nothing with demand paging (every access must go through read/write).
+    vector<uint8_t*> pinFrames(int pid) {
+        lock_guard<mutex> lock(memoryMutex);
+        vector<uint8_t*> pointers;
+        auto it = allocations.find(pid);
+        if (demandPaging || it == allocations.end()) {
+            return pointers;
+        }
+        pointers.reserve(it->second.frames.size());
+        for (int frame : it->second.frames) {
+            pointers.push_back(frameData(frame));
+        }
+        return pointers;
+    }
+
+    size_t getFrameSize() const {
+        return frameSizeBytes.load(memory_order_relaxed);
+    }
+
+    // Reads/writes a uint16_t at a process's virtual address (must be even and
+    // inside the process's memory). Unknown pids read as 0 and ignore writes.
+    uint16_t read(int pid, size_t address) {
+        lock_guard<mutex> lock(memoryMutex);
+        uint8_t* ptr = translate(pid, address, false);
+        uint16_t value = 0;
+        if (ptr != nullptr) memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    void write(int pid, size_t address, uint16_t value) {
+        lock_guard<mutex> lock(memoryMutex);
+        uint8_t* ptr = translate(pid, address, true);
+        if (ptr != nullptr) memcpy(ptr, &value, sizeof(value));
+    }
+
+    MemoryCounters getCounters() const {
+        MemoryCounters counters;
+        counters.frameSize = frameSizeBytes.load(memory_order_relaxed);
+        counters.totalFrames = totalFrameCount.load(memory_order_relaxed);
+        counters.usedFrames = usedFrameCount.load(memory_order_relaxed);
+        counters.pageFaults = pageFaults.load(memory_order_relaxed);
+        counters.pageIns = pageIns.load(memory_order_relaxed);
+        counters.pageOuts = pageOuts.load(memory_order_relaxed);
+        return counters;
+    }
+
+    MemoryStats getStats() const {
+        lock_guard<mutex> lock(memoryMutex);
+        MemoryStats stats;
+        stats.frameSize = frameSize;
+        stats.totalFrames = frameOwner.size();
+        stats.totalBytes = stats.totalFrames * frameSize;
+        stats.usedFrames = stats.totalFrames - freeFrames.size();
+        stats.residentProcesses = static_cast<int>(allocations.size());
+        for (const auto& [pid, alloc] : allocations) {
+            if (demandPaging) {
+                if (!alloc.pageTable.empty() && alloc.pageTable.back().frame >= 0) {
+                    stats.internalFragmentation += alloc.pageTable.size() * frameSize - alloc.bytes;
+                }
+                continue;
+            }
+            stats.usedBytes += alloc.bytes;
+            stats.internalFragmentation += alloc.frames.size() * frameSize - alloc.bytes;
+        }
+        if (demandPaging) {
+            stats.usedBytes = stats.usedFrames * frameSize;
+        }
+        size_t freeBytes = freeFrames.size() * frameSize;
+        if (!demandPaging && processSize > 0 && framesFor(processSize) > freeFrames.size()) {
+            stats.externalFragmentation = freeBytes;
+        }
+        stats.demandPaging = demandPaging;
+        stats.replacementPolicy = policy ? policy->getName() : "";
+        stats.pageFaults = pageFaults;
+        stats.pageIns = pageIns;
+        stats.pageOuts = pageOuts;
+        return stats;
+    }
+
+private:
+    struct PageTableEntry {
+        int frame = -1;   // -1 = not resident
+        int slot = -1;    // backing store slot, -1 = page never written out
+        bool dirty = false;
+    };
+
+    struct Allocation {
+        size_t bytes = 0;
+        vector<int> frames;               // without demand paging
+        vector<PageTableEntry> pageTable; // with demand paging
+    };
+
+    // Caller must hold memoryMutex and have checked freeFrames is not empty
+    int allocateFrame(int pid) {
+        int frame = freeFrames.back();
+        freeFrames.pop_back();
+        frameOwner[frame] = pid;
+        usedFrameCount.fetch_add(1, memory_order_relaxed);
+        return frame;
+    }
+
+    // Caller must hold memoryMutex
+    void freeFrame(int frame) {
+        frameOwner[frame] = -1;
+        framePage[frame] = -1;
+        freeFrames.push_back(frame);
+        usedFrameCount.fetch_sub(1, memory_order_relaxed);
+    }
+
+    uint8_t* frameData(int frame) {
+        return physicalMemory.data() + static_cast<size_t>(frame) * frameSize;
+    }
+
+    // Caller must hold memoryMutex
+    uint8_t* translate(int pid, size_t address, bool isWrite) {
+        auto it = allocations.find(pid);
+        if (it == allocations.end() || address + sizeof(uint16_t) > it->second.bytes) {
+            return nullptr;
+        }
+        Allocation& alloc = it->second;
+        size_t page = address / frameSize;
+        size_t offset = address % frameSize;
+        if (!demandPaging) {
+            return frameData(alloc.frames[page]) + offset;
+        }
+
+        PageTableEntry& entry = alloc.pageTable[page];
+        if (entry.frame < 0) {
+            if (!pageFault(pid, alloc, page)) return nullptr;
+        }
+        else {
+            policy->onAccess(entry.frame);
+        }
+        if (isWrite) entry.dirty = true;
+        return frameData(entry.frame) + offset;
+    }
+
+    // Loads a page into a free frame, evicting a victim if needed.
+    // Caller must hold memoryMutex
+    bool pageFault(int pid, Allocation& alloc, size_t page) {
+        pageFaults++;
+        int frame;
+        if (!freeFrames.empty()) {
+            frame = allocateFrame(pid);
+        }
+        else {
+            frame = policy->pickVictim();
+            if (frame < 0) return false; // no frames at all
+            evict(frame);
+            frameOwner[frame] = pid;
+        }
+        framePage[frame] = static_cast<int>(page);
+
+        PageTableEntry& entry = alloc.pageTable[page];
+        if (entry.slot >= 0) {
+            memcpy(frameData(frame), backingStore.slot(entry.slot), frameSize);
+            pageIns++;
+        }
+        else {
+            memset(frameData(frame), 0, frameSize);
+        }
+        entry.frame = frame;
+        entry.dirty = false;
+        policy->onLoad(frame);
+        return true;
+    }
+
+    // Writes a frame's page to the backing store if it changed since it was loaded.
+    // Caller must hold memoryMutex
+    void evict(int frame) {
+        Allocation& victim = allocations[frameOwner[frame]];
+        PageTableEntry& entry = victim.pageTable[framePage[frame]];
+        if (entry.dirty) {
+            if (entry.slot < 0) entry.slot = backingStore.allocateSlot();
+            memcpy(backingStore.slot(entry.slot), frameData(frame), frameSize);
+            pageOuts++;
+        }
+        entry.frame = -1;
+        entry.dirty = false;
+    }
+
+    size_t frameSize = 2;
+    size_t processSize = 0;
+    bool demandPaging = false;
+    vector<int> frameOwner;      // frame table: owning pid or -1
+    vector<int> framePage;       // frame table: page of the owner held in the frame
+    vector<int> freeFrames;      // free list used as a stack
+    vector<uint8_t> physicalMemory;
+    unordered_map<int, Allocation> allocations;
+    unique_ptr<IReplacementPolicy> policy;
+    BackingStore backingStore;
+    // Written under memoryMutex, atomic so getCounters() can read them without it
+    atomic<uint64_t> pageFaults{ 0 };
+    atomic<uint64_t> pageIns{ 0 };
+    atomic<uint64_t> pageOuts{ 0 };
+    atomic<size_t> usedFrameCount{ 0 };
+    atomic<size_t> totalFrameCount{ 0 };
+    atomic<size_t> frameSizeBytes{ 0 };
+    mutable mutex memoryMutex;
+};
@@ -0,0 +1,125 @@
+#include <winsock2.h>
+#include <afunix.h>
+#include <windows.h>
+#include "metrics.h"
+#include <iostream>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+using namespace std;
+
+/* Metrics server constants */
+const long metrics_poll_timeout_us = 250000; // how often the server checks for stop()
+const int metrics_request_bytes = 512;
+
+bool MetricsServer::start(const string& socketPath, Renderer renderer) {
+    if (running) {
+        return true;
+    }
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        cout << "[METRICS] Winsock initialization failed." << endl;
+        return false;
+    }
+
+    SOCKET sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET) {
+        cout << "[METRICS] Could not create a Unix domain socket." << endl;
+        WSACleanup();
+        return false;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        cout << "[METRICS] Socket path is too long: " << socketPath << endl;
+        closesocket(sock);
+        WSACleanup();
+        return false;
+    }
+    socketPath.copy(addr.sun_path, socketPath.size());
+    DeleteFileA(socketPath.c_str()); // stale socket file from a previous run
+
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR
+        || listen(sock, SOMAXCONN) == SOCKET_ERROR) {
+        cout << "[METRICS] Could not listen on " << socketPath << endl;
+        closesocket(sock);
+        WSACleanup();
+        return false;
+    }
+
+    path = socketPath;
+    render = renderer;
+    listener = static_cast<uintptr_t>(sock);
+    running = true;
+    worker = thread(&MetricsServer::serve, this);
+    cout << "[METRICS] Serving metrics on " << path << endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    closesocket(static_cast<SOCKET>(listener));
+    DeleteFileA(path.c_str());
+    WSACleanup();
+}
+
+void MetricsServer::serve() {
+    // Scrapes must never compete with the CPU cores
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+    SOCKET sock = static_cast<SOCKET>(listener);
+
+    while (running) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(sock, &readable);
+        timeval timeout = { 0, metrics_poll_timeout_us };
+        if (select(static_cast<int>(sock) + 1, &readable, NULL, NULL, &timeout) <= 0) {
+            continue;
+        }
+
+        SOCKET client = accept(sock, NULL, NULL);
+        if (client == INVALID_SOCKET) {
+            continue;
+        }
+
+        // Read the optional request line, but don't wait long for clients that send nothing
+        char request[metrics_request_bytes] = {};
+        fd_set clientReadable;
+        FD_ZERO(&clientReadable);
+        FD_SET(client, &clientReadable);
+        timeval requestTimeout = { 0, 50000 };
+        if (select(static_cast<int>(client) + 1, &clientReadable, NULL, NULL, &requestTimeout) > 0) {
+            recv(client, request, sizeof(request) - 1, 0);
+        }
+        string requestLine(request);
+        bool json = requestLine.find("json") != string::npos;
+        bool http = requestLine.rfind("GET ", 0) == 0;
+
+        string body = render(json);
+        string response;
+        if (http) {
+            response = string("HTTP/1.0 200 OK\r\nContent-Type: ")
+                + (json ? "application/json" : "text/plain; version=0.0.4")
+                + "\r\nContent-Length: " + to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+        }
+        response += body;
+
+        size_t sent = 0;
+        while (sent < response.size()) {
+            int n = send(client, response.data() + sent, static_cast<int>(response.size() - sent), 0);
+            if (n <= 0) {
+                break;
+            }
+            sent += n;
+        }
+        closesocket(client);
+    }
+}
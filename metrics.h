@@ -0,0 +1,45 @@
+/**
+ * @file metrics.h
+ * @brief This file contains the MetricsServer class definition (metrics over a Unix domain socket)
+ */
+
+#pragma once
+#include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+/* ========== METRICS SERVER ========== */
+// Serves a metrics snapshot over an AF_UNIX socket from a low-priority thread.
+// A client connects and may send a request line: anything containing "json" gets
+// JSON, otherwise Prometheus text; an HTTP "GET" gets an HTTP response so
+// `curl --unix-socket <path> http://localhost/metrics` works. The connection is
+// closed after each snapshot. Rendering is done by the callback, which must only
+// read lock-free counters.
+class MetricsServer {
+public:
+    using Renderer = function<string(bool json)>;
+
+    ~MetricsServer() {
+        stop();
+    }
+
+    bool start(const string& socketPath, Renderer renderer); // defined in metrics.cpp
+    void stop();
+
+    bool isRunning() const {
+        return running;
+    }
+
+private:
+    void serve();
+
+    string path;
+    Renderer render;
+    thread worker;
+    atomic<bool> running{ false };
+    uintptr_t listener = 0; // SOCKET
+};
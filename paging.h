@@ -0,0 +1,268 @@
+/**
+ * @file paging.h
+ * @brief This file contains the page replacement policies and the memory-mapped backing store
+ */
+
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+
+using namespace std;
+
+/* ========== REPLACEMENT POLICY INTERFACE ========== */
+// Tracks which resident frame to evict next. Frames are reported when a page
+// is loaded into them, when they are touched, and when they become free.
+class IReplacementPolicy {
+public:
+    virtual void reset(size_t numFrames) = 0;
+    virtual void onLoad(int frame) = 0;
+    virtual void onAccess(int frame) = 0;
+    virtual void onFree(int frame) = 0;
+    virtual int pickVictim() = 0;
+    virtual string getName() const = 0;
+    virtual ~IReplacementPolicy() = default;
+};
+
+/* ========== FIFO ========== */
+class FifoPolicy : public IReplacementPolicy {
+    list<int> order; // oldest load at the front; only resident frames, so it never outgrows the frame table
+    vector<list<int>::iterator> position;
+    vector<bool> resident;
+public:
+    void reset(size_t numFrames) override {
+        order.clear();
+        position.assign(numFrames, order.end());
+        resident.assign(numFrames, false);
+    }
+    void onLoad(int frame) override {
+        if (resident[frame]) order.erase(position[frame]);
+        position[frame] = order.insert(order.end(), frame);
+        resident[frame] = true;
+    }
+    void onAccess(int) override {}
+    void onFree(int frame) override {
+        if (!resident[frame]) return;
+        order.erase(position[frame]);
+        resident[frame] = false;
+    }
+    int pickVictim() override {
+        if (order.empty()) return -1;
+        int frame = order.front();
+        order.pop_front();
+        resident[frame] = false;
+        return frame;
+    }
+    string getName() const override {
+        return "fifo";
+    }
+};
+
+/* ========== LRU ========== */
+class LruPolicy : public IReplacementPolicy {
+    list<int> order; // least recently used at the front
+    vector<list<int>::iterator> position;
+    vector<bool> resident;
+public:
+    void reset(size_t numFrames) override {
+        order.clear();
+        position.assign(numFrames, order.end());
+        resident.assign(numFrames, false);
+    }
+    void onLoad(int frame) override {
+        if (resident[frame]) order.erase(position[frame]);
+        position[frame] = order.insert(order.end(), frame);
+        resident[frame] = true;
+    }
+    void onAccess(int frame) override {
+        if (resident[frame]) order.splice(order.end(), order, position[frame]);
+    }
+    void onFree(int frame) override {
+        if (!resident[frame]) return;
+        order.erase(position[frame]);
+        resident[frame] = false;
+    }
+    int pickVictim() override {
+        if (order.empty()) return -1;
+        int frame = order.front();
+        order.pop_front();
+        resident[frame] = false;
+        return frame;
+    }
+    string getName() const override {
+        return "lru";
+    }
+};
+
+/* ========== CLOCK (second chance) ========== */
+class ClockPolicy : public IReplacementPolicy {
+    vector<bool> referenced;
+    vector<bool> resident;
+    size_t hand = 0;
+    size_t residentCount = 0;
+public:
+    void reset(size_t numFrames) override {
+        referenced.assign(numFrames, false);
+        resident.assign(numFrames, false);
+        hand = 0;
+        residentCount = 0;
+    }
+    void onLoad(int frame) override {
+        if (!resident[frame]) residentCount++;
+        resident[frame] = true;
+        referenced[frame] = true;
+    }
+    void onAccess(int frame) override {
+        referenced[frame] = true;
+    }
+    void onFree(int frame) override {
+        if (resident[frame]) residentCount--;
+        resident[frame] = false;
+        referenced[frame] = false;
+    }
+    int pickVictim() override {
+        if (residentCount == 0) return -1;
+        while (true) {
+            size_t frame = hand;
+            hand = (hand + 1) % resident.size();
+            if (!resident[frame]) continue;
+            if (referenced[frame]) {
+                referenced[frame] = false;
+                continue;
+            }
+            onFree(static_cast<int>(frame));
+            return static_cast<int>(frame);
+        }
+    }
+    string getName() const override {
+        return "clock";
+    }
+};
+
+inline unique_ptr<IReplacementPolicy> makeReplacementPolicy(const string& name) {
+    if (name == "lru") return make_unique<LruPolicy>();
+    if (name == "clock") return make_unique<ClockPolicy>();
+    return make_unique<FifoPolicy>();
+}
+
+/* ========== BACKING STORE ========== */
+// Page-sized slots in a memory-mapped file. Pages move between the emulated
+// frames and the mapped view with a single memcpy, with no read/write calls
+// or intermediate buffers. Falls back to a heap buffer if the mapping fails.
+class BackingStore {
+public:
+    ~BackingStore() {
+        close();
+    }
+
+    void open(const string& filePath, size_t slotBytes, size_t initialSlots) {
+        close();
+        path = filePath;
+        slotSize = slotBytes;
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            cout << "[PAGING] Could not create " << path << ", keeping evicted pages in RAM." << endl;
+        }
+        grow(initialSlots > 0 ? initialSlots : 1);
+    }
+
+    void close() {
+        unmap();
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+        fallback.clear();
+        freeSlots.clear();
+        capacity = 0;
+        nextSlot = 0;
+    }
+
+    int allocateSlot() {
+        if (!freeSlots.empty()) {
+            int slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+            return slotIndex;
+        }
+        if (nextSlot == capacity) {
+            grow(capacity * 2);
+        }
+        return static_cast<int>(nextSlot++);
+    }
+
+    void freeSlot(int slotIndex) {
+        freeSlots.push_back(slotIndex);
+    }
+
+    uint8_t* slot(int slotIndex) {
+        return base() + static_cast<size_t>(slotIndex) * slotSize;
+    }
+
+private:
+    uint8_t* base() {
+        return view != nullptr ? view : fallback.data();
+    }
+
+    void grow(size_t slots) {
+        size_t bytes = slots * slotSize;
+        if (file != INVALID_HANDLE_VALUE) {
+            // Map the larger view before dropping the current one, so if it fails
+            // the pages already evicted to the file can still be copied out
+            uint64_t size = bytes;
+            HANDLE grownMapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), NULL);
+            uint8_t* grownView = nullptr;
+            if (grownMapping != NULL) {
+                grownView = static_cast<uint8_t*>(MapViewOfFile(grownMapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+            }
+            if (grownView != nullptr) {
+                unmap();
+                mapping = grownMapping;
+                view = grownView;
+            }
+            else {
+                cout << "[PAGING] Could not map " << path << ", keeping evicted pages in RAM." << endl;
+                if (grownMapping != NULL) CloseHandle(grownMapping);
+                if (view != nullptr) {
+                    fallback.assign(view, view + capacity * slotSize);
+                }
+                unmap();
+                CloseHandle(file);
+                file = INVALID_HANDLE_VALUE;
+            }
+        }
+        if (view == nullptr) {
+            fallback.resize(bytes);
+        }
+        capacity = slots;
+    }
+
+    void unmap() {
+        if (view != nullptr) {
+            UnmapViewOfFile(view);
+            view = nullptr;
+        }
+        if (mapping != NULL) {
+            CloseHandle(mapping);
+            mapping = NULL;
+        }
+    }
+
+    string path;
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+    uint8_t* view = nullptr;
+    vector<uint8_t> fallback;
+    size_t slotSize = 0;
+    size_t capacity = 0;
+    size_t nextSlot = 0;
+    vector<int> freeSlots;
+};
@@ -18,11 +18,20 @@
 #include <unordered_map>
 #include <queue>
 #include <deque>
+#include <list>
 #include <ctime>
+#include <memory>
+#include "memory.h"
+#include "simd.h"
+#include "submission.h"
+#include "metrics.h"
 
 using namespace std;
 
 /* ========== PROCESS CONTEXT INTERFACE ========== */
+// Interface an instruction runs against. Instruction::execute is a template, so
+// when it is given a concrete (final) context such as Process the calls are
+// bound statically and can be inlined; IProcessContext& still works for other contexts.
 class IProcessContext {
 public:
     virtual void log(const std::string& message) = 0;
@@ -41,6 +50,13 @@ enum InstructionType {
 };
 
 /* ========== INSTRUCTION STRUCT ========== */
+// Destination and source values of an ADD/SUBTRACT, resolved but not yet computed
+struct ArithmeticOperands {
+    string dest;
+    uint16_t lhs = 0;
+    uint16_t rhs = 0;
+};
+
 class Instruction {
     InstructionType type;
 public:
@@ -50,7 +66,34 @@ public:
         return type;
     }
 
-    void execute(IProcessContext& context) {
+    // Picks the three variables of an ADD/SUBTRACT: each one is either an existing
+    // "varN" or a new random variable declared with a random value.
+    template <typename Context>
+    static ArithmeticOperands prepareArithmetic(Context& context) {
+        string varNames[3] = { "", "", "" };
+        uint16_t values[3];
+        for (int i = 0; i < 3; ++i) {
+            bool useExisting = (rand() % 2 == 0);
+            if (useExisting) {
+                string name = "var" + to_string(rand() % 10);
+                varNames[i] = name;
+                values[i] = context.getSymbol(name);
+            }
+            else {
+                int length = 5;
+                static const char charset[] = "abcdefghijklmnopqrstuvwxyz";
+                for (int j = 0; j < length; ++j) {
+                    varNames[i] += charset[rand() % (sizeof(charset) - 1)];
+                }
+                values[i] = static_cast<uint16_t>(rand() % 65536);
+                context.setSymbol(varNames[i], values[i]);
+            }
+        }
+        return { varNames[0], values[1], values[2] };
+    }
+
+    template <typename Context>
+    void execute(Context& context) {
         switch (type) {
         case PRINT: {
             context.log("Hello world from " + context.getName() + "!");
@@ -69,51 +112,13 @@ public:
             break;
         }
         case ADD: {
-            string varNames[3] = { "", "", "" };
-            uint16_t values[3];
-            for (int i = 0; i < 3; ++i) {
-                bool useExisting = (rand() % 2 == 0);
-                if (useExisting) {
-                    string name = "var" + to_string(rand() % 10);
-                    varNames[i] = name;
-                    values[i] = context.getSymbol(name);
-                }
-                else {
-                    int length = 5;
-                    static const char charset[] = "abcdefghijklmnopqrstuvwxyz";
-                    for (int j = 0; j < length; ++j) {
-                        varNames[i] += charset[rand() % (sizeof(charset) - 1)];
-                    }
-                    values[i] = static_cast<uint16_t>(rand() % 65536);
-                    context.setSymbol(varNames[i], values[i]);
-                }
-            }
-            values[0] = values[1] + values[2];
-            context.setSymbol(varNames[0], values[0]);
+            ArithmeticOperands ops = prepareArithmetic(context);
+            context.setSymbol(ops.dest, static_cast<uint16_t>(ops.lhs + ops.rhs));
             break;
         }
         case SUBTRACT: {
-            string varNames[3] = { "", "", "" };
-            uint16_t values[3];
-            for (int i = 0; i < 3; ++i) {
-                bool useExisting = (rand() % 2 == 0);
-                if (useExisting) {
-                    string name = "var" + to_string(rand() % 10);
-                    varNames[i] = name;
-                    values[i] = context.getSymbol(name);
-                }
-                else {
-                    int length = 5;
-                    static const char charset[] = "abcdefghijklmnopqrstuvwxyz";
-                    for (int j = 0; j < length; ++j) {
-                        varNames[i] += charset[rand() % (sizeof(charset) - 1)];
-                    }
-                    values[i] = static_cast<uint16_t>(rand() % 65536);
-                    context.setSymbol(varNames[i], values[i]);
-                }
-            }
-            values[0] = values[1] - values[2];
-            context.setSymbol(varNames[0], values[0]);
+            ArithmeticOperands ops = prepareArithmetic(context);
+            context.setSymbol(ops.dest, static_cast<uint16_t>(ops.lhs - ops.rhs));
             break;
         }
         case SLEEP: {
@@ -159,21 +164,58 @@ public:
     }
 };
 
+/* ========== STEP RESULT ========== */
+// Outcome of one Process::executeNextInstruction call
+enum StepResult {
+    STEP_EXECUTED, // an instruction ran and was retired
+    STEP_SLEPT,    // a SLEEP tick was counted down; nothing ran
+    STEP_FINISHED  // no instructions left; the process is now finished
+};
+
+/* ========== RELAXED FIELD ========== */
+// Process state written by the core running it and read by screen and report
+// threads. Readers only need a recent value, not ordering with other fields,
+// so relaxed atomics are enough. Copyable so Process stays movable.
+template <typename T>
+class RelaxedField {
+public:
+    RelaxedField(T v = T()) : value(v) {}
+    RelaxedField(const RelaxedField& other) : value(other.load()) {}
+    RelaxedField& operator=(const RelaxedField& other) { store(other.load()); return *this; }
+    RelaxedField& operator=(T v) { store(v); return *this; }
+    operator T() const { return load(); }
+    T load() const { return value.load(memory_order_relaxed); }
+    void store(T v) { value.store(v, memory_order_relaxed); }
+    T operator++(int) { T old = load(); store(old + 1); return old; } // single writer: the owning core
+
+private:
+    atomic<T> value;
+};
+
 /* ========== PROCESS CLASS ========== */
-class Process : public IProcessContext {
+class Process final : public IProcessContext {
 public:
     string name;
     int pid;
     vector<Instruction> instructions;
-    unordered_map<string, uint16_t> symbolTable;
+    unordered_map<string, uint16_t> symbolTable; // variable name -> virtual address in emulated memory
     vector<string> outputLog;
-    int currentInstruction = 0;
+    RelaxedField<int> currentInstruction{ 0 };
     int sleepCounter = 0;
-    bool isFinished = false;
+    RelaxedField<bool> isFinished{ false };
     string createdAt;
-    int coreId = -1;
+    RelaxedField<int> coreId{ -1 };
     int quantumLeft = 0;
     int forLoopDepth = 0;
+    unique_ptr<mutex> logMutex = make_unique<mutex>(); // guards outputLog against screen readers
+    MemoryManager* memory = nullptr; // set while the process holds emulated memory
+    size_t memoryBytes = 0;
+    vector<uint8_t*> frames;         // pinned frame pointers without demand paging, else empty
+    size_t frameBytes = 0;
+    int reportedInstruction = -1; // progress written by the last report-util
+    chrono::steady_clock::time_point enqueuedAt; // last time the process entered the ready queue
+    bool external = false;      // submitted through the shared-memory ring
+    uint64_t submissionTag = 0; // producer's tag, echoed in its completion
 
     Process() {}
 
@@ -185,35 +227,88 @@ public:
         instructions.push_back(inst);
     }
 
-    bool executeNextInstruction(int delays) {
+    StepResult executeNextInstruction(int delays) {
         if (sleepCounter > 0) {
             sleepCounter--;
-            return false;
+            return STEP_SLEPT;
         }
         if (currentInstruction >= instructions.size()) {
             isFinished = true;
-            return true;
+            return STEP_FINISHED;
         }
         Instruction& inst = instructions[currentInstruction];
-        inst.execute(*this); // Pass as IProcessContext
+        inst.execute(*this); // Statically bound to Process, no virtual dispatch
+        retireInstruction(delays);
+        return STEP_EXECUTED;
+    }
+
+    // Lockstep execution: the instruction that would run next, or nullptr if the
+    // process is sleeping or has no instructions left.
+    Instruction* peekNextInstruction() {
+        if (sleepCounter > 0 || static_cast<size_t>(currentInstruction) >= instructions.size()) {
+            return nullptr;
+        }
+        return &instructions[currentInstruction];
+    }
+
+    // Moves past an instruction whose effect was applied outside execute()
+    void retireInstruction(int delays) {
         int i = 0;
         while (i < delays) {
             i++;
         }
         currentInstruction++;
-        return false;
     }
 
     // IProcessContext interface implementation
     void log(const std::string& message) override {
+        lock_guard<mutex> lock(*logMutex);
         outputLog.push_back(message);
     }
+    // Gives the process its emulated memory. Without demand paging the frames
+    // are pinned here, so variable access skips the memory manager's lock.
+    void attachMemory(MemoryManager* manager, size_t bytes) {
+        memory = manager;
+        memoryBytes = bytes;
+        frames = manager->pinFrames(pid);
+        frameBytes = manager->getFrameSize();
+    }
+    void detachMemory() {
+        memory = nullptr;
+        frames.clear();
+    }
+    // Values are 2-byte aligned and frames have an even size, so one never straddles two frames
+    uint8_t* pinnedAddress(uint16_t address) const {
+        return frames[address / frameBytes] + address % frameBytes;
+    }
+    // Variables live in the process's emulated memory, 2 bytes each.
+    // Once the memory is full, new variables are ignored.
     void setSymbol(const std::string& name, uint16_t value) override {
-        symbolTable[name] = value;
+        if (memory == nullptr) {
+            return;
+        }
+        auto it = symbolTable.find(name);
+        if (it == symbolTable.end()) {
+            size_t address = symbolTable.size() * sizeof(uint16_t);
+            if (address + sizeof(uint16_t) > min(memoryBytes, static_cast<size_t>(65536))) {
+                return;
+            }
+            it = symbolTable.emplace(name, static_cast<uint16_t>(address)).first;
+        }
+        if (!frames.empty()) memcpy(pinnedAddress(it->second), &value, sizeof(value));
+        else memory->write(pid, it->second, value);
     }
     uint16_t getSymbol(const std::string& name) const override {
         auto it = symbolTable.find(name);
-        return it != symbolTable.end() ? it->second : 0;
+        if (it == symbolTable.end() || memory == nullptr) {
+            return 0;
+        }
+        if (frames.empty()) {
+            return memory->read(pid, it->second);
+        }
+        uint16_t value;
+        memcpy(&value, pinnedAddress(it->second), sizeof(value));
+        return value;
     }
     std::string getName() const override {
         return name;
@@ -228,8 +323,7 @@ public:
         return forLoopDepth;
     }
 
-private:
-    string getCurrentTimestamp() {
+    static string getCurrentTimestamp() {
         time_t now = time(0);
         tm ltm;
         localtime_s(&ltm, &now);
@@ -239,50 +333,184 @@ private:
     }
 };
 
+/* ========== PROCESS SNAPSHOT ========== */
+// Copy of the live state of a process, used by the screen view so it never
+// has to hold on to the Process itself or copy its whole output log.
+struct ProcessSnapshot {
+    string name;
+    int pid = -1;
+    int currentInstruction = 0;
+    size_t totalInstructions = 0;
+    int coreId = -1;
+    bool isFinished = false;
+    string createdAt;
+    size_t logSize = 0;
+    vector<string> logTail;
+    bool archived = false; // log and instructions already released
+};
+
+/* ========== READY QUEUE STATS ========== */
+struct ReadyQueueStats {
+    size_t depth = 0;
+    size_t peakDepth = 0;
+    size_t pendingDepth = 0;      // admitted but waiting for room in the ready queue
+    uint64_t admitted = 0;        // processes put on the ready queue or pending list
+    uint64_t admissionRate = 0;   // admitted during the last ~second
+    uint64_t dropped = 0;         // generations discarded by the "drop" policy
+    uint64_t backpressureTicks = 0; // scheduler ticks the generator was held back
+    uint64_t dispatched = 0;      // processes taken off the ready queue by a core
+    double totalWaitMs = 0.0;
+    double maxWaitMs = 0.0;
+};
+
+/* ========== PROCESS ARCHIVE ========== */
+// What is left of a process once it finishes: everything else (instructions,
+// symbol table, output log) is freed.
+struct ProcessArchive {
+    int pid = -1;
+    string name;
+    string createdAt;
+    string finishedAt;
+    size_t instructionCount = 0;
+    size_t logLines = 0;
+    size_t variables = 0;
+    int lastCore = -1;
+    bool reported = false; // written by a report-util since it was archived
+
+    // One line of the append-only archive file
+    string toRecord() const {
+        return to_string(pid) + "|" + name + "|" + createdAt + "|" + finishedAt + "|"
+            + to_string(instructionCount) + "|" + to_string(logLines) + "|"
+            + to_string(variables) + "|" + to_string(lastCore);
+    }
+};
+
+/* ========== SCHEDULING POLICIES ========== */
+// Compile-time tags for CPUScheduler::runCore
+struct FcfsPolicy {
+    static constexpr bool preemptive = false;
+};
+
+struct RoundRobinPolicy {
+    static constexpr bool preemptive = true;
+};
+
+/* ========== CORE COUNTERS ========== */
+const int MAX_CORES = 256;
+
+// Per-core wall-clock time split in microseconds, measured with steady_clock
+// (so it includes delays-per-exec and the real length of each sleep).
+// Each core owns its own cache line.
+struct alignas(64) CoreCounters {
+    atomic<uint64_t> busyUs{ 0 };
+    atomic<uint64_t> idleUs{ 0 };
+
+    // Adds the time since `since` to `counter` and restarts the interval
+    static void accumulate(atomic<uint64_t>& counter, chrono::steady_clock::time_point& since) {
+        auto now = chrono::steady_clock::now();
+        counter.fetch_add(chrono::duration_cast<chrono::microseconds>(now - since).count(), memory_order_relaxed);
+        since = now;
+    }
+};
+
 /* ========== CPU SCHEDULER ========== */
 class CPUScheduler {
 public:
+    // Atomic fields can be changed by reload-config while the scheduler runs
     struct Config {
-        int numCpu = 4;
+        atomic<int> numCpu{ 4 };
         string scheduler = "rr"; // "rr" for Round Robin
-        int quantumCycles = 5;
-        int batchProcessFreq = 1;
-        int minIns = 1000;
-        int maxIns = 1000;
-        int delaysPerExec = 0;
+        atomic<int> quantumCycles{ 5 };
+        atomic<int> batchProcessFreq{ 1 };
+        atomic<int> minIns{ 1000 };
+        atomic<int> maxIns{ 1000 };
+        atomic<int> delaysPerExec{ 0 };
+        size_t maxOverallMem = 16384;
+        size_t memPerFrame = 16;
+        size_t memPerProc = 4096;
+        bool demandPaging = false;
+        string pageReplacement = "fifo"; // "fifo", "lru" or "clock"
+        bool archiveSpill = false;       // move old archive records to archiveFile
+        string archiveFile = "csopesy-archive.txt";
+        size_t archiveMemoryRecords = 1000; // archive records kept in memory when spilling
+        atomic<size_t> readyQueueCapacity{ 0 }; // max processes waiting to run (queued or waiting for memory), 0 = unbounded
+        string readyQueuePolicy = "block";  // "block", "drop" or "defer" when the ready queue is full
+        size_t lockstepLanes = 0;           // >1: each core steps this many processes together
+        bool submissionRing = false;        // accept processes from other programs through shared memory
+        string submissionRingName = "Local\\csopesy-submit";
+        uint32_t submissionRingCapacity = 65536; // entries, power of two
+        uint64_t submissionArenaBytes = 16 * 1024 * 1024;
+        bool metrics = false;               // serve metrics over a Unix domain socket
+        string metricsSocket = "csopesy-metrics.sock";
+        bool reportCompress = false;        // write report-util output as csopesy-log.txt.gz
+        size_t reportWorkers = 0;           // report formatting threads, 0 = one per hardware thread
     } config;
 
     CPUScheduler() : isRunning(false), cpuCycles(0) {}
 
     ~CPUScheduler() {
+        metricsServer.stop(); // its renderer reads this scheduler's counters
         stopScheduler();
     }
 
     bool loadConfig() {
-        ifstream file("config.txt"); // ifstream file("../config.txt"); <- this worked for Amor but not for Gio, try to switch between these two if needed
-        if (!file.is_open()) {
+        if (!parseConfig(config)) {
             cout << "[CONFIG] Config file not found. Using default values." << endl;
+            configureMemory();
             return true; // Still consider it a success with defaults
         }
-        string line;
-        while (getline(file, line)) {
-            istringstream iss(line);
-            string param, value;
-            if (iss >> param >> value) {
-                if (param == "num-cpu") config.numCpu = stoi(value);
-                else if (param == "scheduler") config.scheduler = value;
-                else if (param == "quantum-cycles") config.quantumCycles = stoi(value);
-                else if (param == "batch-process-freq") config.batchProcessFreq = stoi(value);
-                else if (param == "min-ins") config.minIns = stoi(value);
-                else if (param == "max-ins") config.maxIns = stoi(value);
-                else if (param == "delays-per-exec") config.delaysPerExec = stoi(value);
-            }
+        configureMemory();
+        openSubmissionRing();
+        if (config.metrics) {
+            metricsServer.start(config.metricsSocket, [this](bool json) { return renderMetrics(json); });
         }
-        file.close();
         cout << "[CONFIG] Configuration loaded successfully." << endl;
         return true;
     }
 
+    // Re-reads config.txt and applies the runtime-adjustable values. If the scheduler
+    // is running, cores are added or drained in place and the quantum changes
+    // for the next time slice; other parameters need a restart of the emulator.
+    void reloadConfig() {
+        Config fresh;
+        if (!parseConfig(fresh)) {
+            cout << "[CONFIG] Config file not found. Nothing reloaded." << endl;
+            return;
+        }
+        if (fresh.minIns > fresh.maxIns || fresh.numCpu < 1) {
+            cout << "[CONFIG] Invalid num-cpu or min-ins/max-ins. Nothing reloaded." << endl;
+            return;
+        }
+
+        if (fresh.scheduler != config.scheduler || fresh.maxOverallMem != config.maxOverallMem
+            || fresh.memPerFrame != config.memPerFrame || fresh.memPerProc != config.memPerProc
+            || fresh.demandPaging != config.demandPaging || fresh.pageReplacement != config.pageReplacement
+            || fresh.archiveSpill != config.archiveSpill || fresh.archiveFile != config.archiveFile
+            || fresh.archiveMemoryRecords != config.archiveMemoryRecords
+            || fresh.readyQueuePolicy != config.readyQueuePolicy || fresh.lockstepLanes != config.lockstepLanes
+            || fresh.submissionRing != config.submissionRing || fresh.submissionRingName != config.submissionRingName
+            || fresh.submissionRingCapacity != config.submissionRingCapacity
+            || fresh.submissionArenaBytes != config.submissionArenaBytes
+            || fresh.metrics != config.metrics || fresh.metricsSocket != config.metricsSocket) {
+            cout << "[CONFIG] scheduler, memory, paging, archive, ready-queue-policy, lockstep-lanes, submission ring and metrics changes "
+                << "need a restart of the emulator; keeping current values." << endl;
+        }
+
+        config.quantumCycles = fresh.quantumCycles.load();
+        config.batchProcessFreq = fresh.batchProcessFreq.load();
+        config.delaysPerExec = fresh.delaysPerExec.load();
+        config.maxIns = fresh.maxIns.load();
+        config.minIns = fresh.minIns.load();
+        config.reportCompress = fresh.reportCompress; // only read by report-util on this thread
+        config.reportWorkers = fresh.reportWorkers;
+        {
+            lock_guard<mutex> qlock(queueMutex);
+            config.readyQueueCapacity = fresh.readyQueueCapacity.load();
+        }
+        resizeCores(fresh.numCpu);
+        cout << "[CONFIG] Configuration reloaded." << endl;
+    }
+
     void startScheduler() {
         if (isRunning) {
             cout << "[SCHEDULER] Scheduler is already running." << endl;
@@ -297,86 +525,78 @@ public:
         cout << "[SCHEDULER] Starting " << schedulerType << " scheduler with "
             << config.numCpu << " CPU cores" << endl;
 
+        // Pick the policy once; each core runs a loop specialized for it
+        bool lockstep = config.lockstepLanes > 1;
+        if (config.scheduler == "rr") {
+            coreLoop = lockstep ? &CPUScheduler::runLockstepCore<RoundRobinPolicy> : &CPUScheduler::runCore<RoundRobinPolicy>;
+        }
+        else {
+            coreLoop = lockstep ? &CPUScheduler::runLockstepCore<FcfsPolicy> : &CPUScheduler::runCore<FcfsPolicy>;
+        }
+        if (lockstep) {
+            cout << "[SCHEDULER] Lockstep execution: " << config.lockstepLanes << " processes per core ("
+                << CSOPESY_SIMD_NAME << " arithmetic)" << endl;
+        }
         for (int i = 0; i < config.numCpu; ++i) {
-            cpuCores.emplace_back([this, schedulerType, i]() {
-                while (isRunning) {
-                    Process* currentProcess = nullptr;
-                    bool hasWork = false;
-
-                    // Lock the queue to get a process
-                    {
-                        lock_guard<mutex> lock(queueMutex);
-                        if (!readyQueue.empty()) {
-                            currentProcess = readyQueue.front();
-                            readyQueue.pop();
-                            hasWork = true;
-                        }
-                    }
-
-                    if (!hasWork) {
-                        this_thread::sleep_for(chrono::milliseconds(100));
-                        continue;
-                    }
-
-                    if (schedulerType == "FCFS") {
-                        // FCFS
-                        cout << "[CPU " << i << "] Executing process: "
-                            << currentProcess->name << endl;
-
-                        while (!currentProcess->isFinished) {
-                            bool finished = currentProcess->executeNextInstruction(config.delaysPerExec);
-
-                            // Check if process finished
-                            if (finished) {
-                                lock_guard<mutex> lock(schedulerMutex);
-                                cout << "[CPU " << i << "] Process "
-                                    << currentProcess->name << " finished execution" << endl;
-                                break;
-                            }
-
-                            this_thread::sleep_for(chrono::milliseconds(1));
-                        }
-                    }
-                    else if (schedulerType == "Round Robin") {
-                        // Round Robin
-                    }
-                }
-                });
+            cpuCores.emplace_back(coreLoop, this, i);
         }
 
         // Start the scheduler thread (for status output and process generation)
-        schedulerThread = thread([this, schedulerType]() {
+        schedulerThread = thread([this]() {
+            bool generationOwed = false;
+            uint64_t admittedAtLastSecond = 0;
+            uint64_t retiredAtLastSecond = 0;
             while (isRunning) {
                 cpuCycles++;
 
                 if (config.batchProcessFreq <= 1 || cpuCycles % config.batchProcessFreq == 0) {
-                    string pname = "P" + to_string(nextPid);
-                    Process newProc(pname, nextPid++);
-
-                    int numInstructions = config.minIns + rand() % (config.maxIns - config.minIns + 1);
-                    for (int i = 0; i < numInstructions; ++i) {
-                        InstructionType t = static_cast<InstructionType>(rand() % 6);
-                        newProc.addInstruction(Instruction(t));
+                    if (generationOwed && config.readyQueuePolicy == "drop") {
+                        lock_guard<mutex> qlock(queueMutex);
+                        queueStats.dropped++;
                     }
+                    generationOwed = true;
+                }
 
-                    // Print instruction count for validation
-                    cout << "[SCHEDULER] New process generated: " << pname
-                        << " with " << newProc.instructions.size() << " instructions" << endl;
+                // Backpressure: while the admission backlog is full, "block" holds the next process
+                // back until a core frees a slot, "drop" discards it, "defer" generates it anyway
+                // and parks it on the pending list.
+                if (generationOwed && config.readyQueuePolicy != "defer" && isAdmissionBacklogFull()) {
+                    lock_guard<mutex> qlock(queueMutex);
+                    queueStats.backpressureTicks++;
+                }
+                else if (generationOwed) {
+                    generationOwed = false;
+                    int pid = nextPid++;
+                    Process newProc("P" + to_string(pid), pid);
+                    populateInstructions(newProc);
 
                     {
                         lock_guard<mutex> lock(schedulerMutex);
+                        // A user's 'screen -s P<n>' may already hold this name
+                        if (nameTaken(newProc.name)) newProc.name += "-" + to_string(pid);
+
+                        // Print instruction count for validation
+                        cout << "[SCHEDULER] New process generated: " << newProc.name
+                            << " with " << newProc.instructions.size() << " instructions" << endl;
                         processes.push_back(std::move(newProc));
                         Process* pPtr = &processes.back();
-                        lock_guard<mutex> qlock(queueMutex);
-                        if (schedulerType == "Round Robin") {
-                            rrQueue.push_back(pPtr);
-                        }
-                        else {
-                            readyQueue.push(pPtr);
-                        }
+                        processIndex[pPtr->name] = prev(processes.end());
+                        admitProcess(pPtr);
                     }
                 }
 
+                consumeSubmissions();
+
+                if (cpuCycles % 100 == 0) {
+                    // ~1 second of scheduler ticks
+                    lock_guard<mutex> qlock(queueMutex);
+                    queueStats.admissionRate = queueStats.admitted - admittedAtLastSecond;
+                    admittedAtLastSecond = queueStats.admitted;
+                    uint64_t retired = instructionsRetired;
+                    instructionRate = retired - retiredAtLastSecond;
+                    retiredAtLastSecond = retired;
+                }
+
                 if (cpuCycles % 1000 == 0) {
                     lock_guard<mutex> lock(schedulerMutex);
                     cout << "[SCHEDULER] CPU Cycles: " << cpuCycles
@@ -412,39 +632,836 @@ public:
 
     bool findProcess(const string& name) {
         lock_guard<mutex> lock(schedulerMutex);
-        for (const auto& proc : processes) {
-            if (proc.name == name) {
-                return true;
-            }
-        }
-        return false;
+        return nameTaken(name);
     }
 
     // Add a process to the scheduler
-    void addProcess(const string& name) {
+    // Returns false if the name is already used by a live or archived process
+    bool addProcess(const string& name) {
         lock_guard<mutex> lock(schedulerMutex);
+        if (nameTaken(name)) {
+            return false;
+        }
         int pid = nextPid++;
         processes.push_back(Process(name, pid));
+        Process* pPtr = &processes.back();
+        populateInstructions(*pPtr);
+        processIndex[name] = prev(processes.end());
+        admitProcess(pPtr);
         cout << "[SCHEDULER] Process '" << name << "' added with PID " << pid << endl;
+        return true;
+    }
+
+    // Copy the live state of a process plus the last `tailLines` lines of its log.
+    // Returns false if no process has that name.
+    bool getProcessSnapshot(const string& name, ProcessSnapshot& out, size_t tailLines) {
+        lock_guard<mutex> lock(schedulerMutex);
+        auto it = processIndex.find(name);
+        if (it == processIndex.end()) {
+            auto archived = archiveIndex.find(name);
+            if (archived == archiveIndex.end()) {
+                return false;
+            }
+            out = snapshotOf(archived->second);
+            return true;
+        }
+        const Process& p = *it->second;
+        out.name = p.name;
+        out.pid = p.pid;
+        out.currentInstruction = p.currentInstruction;
+        out.totalInstructions = p.instructions.size();
+        out.coreId = p.coreId;
+        out.isFinished = p.isFinished;
+        out.createdAt = p.createdAt;
+
+        lock_guard<mutex> logLock(*p.logMutex);
+        out.logSize = p.outputLog.size();
+        size_t first = out.logSize > tailLines ? out.logSize - tailLines : 0;
+        out.logTail.assign(p.outputLog.begin() + first, p.outputLog.end());
+        return true;
     }
 
     // Get current CPU cycle count
     uint64_t getCpuCycles() const {
         return cpuCycles;
     }
-    const vector<Process>& getAllProcesses() const { return processes; } // Added for screen-ls
+
+    // Snapshots (without log tails) of the in-memory archived processes, then the live ones
+    // Snapshots for report-util. With changedOnly, only processes that made
+    // progress or were archived since the last markReported() are returned.
+    vector<ProcessSnapshot> getReportSnapshots(bool changedOnly) {
+        lock_guard<mutex> lock(schedulerMutex);
+        vector<ProcessSnapshot> changed;
+        changed.reserve(changedOnly ? 0 : archiveIndex.size() + processes.size());
+        for (const string& name : archiveOrder) {
+            const ProcessArchive& record = archiveIndex.at(name);
+            if (changedOnly && record.reported) continue;
+            changed.push_back(snapshotOf(record));
+        }
+        for (const Process& p : processes) {
+            int progress = p.currentInstruction;
+            if (changedOnly && progress == p.reportedInstruction) continue;
+            ProcessSnapshot snap;
+            snap.name = p.name;
+            snap.pid = p.pid;
+            snap.currentInstruction = progress;
+            snap.totalInstructions = p.instructions.size();
+            snap.coreId = p.coreId;
+            snap.isFinished = p.isFinished;
+            snap.createdAt = p.createdAt;
+            changed.push_back(move(snap));
+        }
+        return changed;
+    }
+
+    // Records what a report wrote, once it is safely on disk. A process archived
+    // since its snapshot stays unreported: its final state hasn't been written.
+    void markReported(const vector<ProcessSnapshot>& written) {
+        lock_guard<mutex> lock(schedulerMutex);
+        for (const ProcessSnapshot& snap : written) {
+            if (snap.archived) {
+                auto it = archiveIndex.find(snap.name);
+                if (it != archiveIndex.end()) it->second.reported = true;
+            }
+            else {
+                auto it = processIndex.find(snap.name);
+                if (it != processIndex.end()) it->second->reportedInstruction = snap.currentInstruction;
+            }
+        }
+        reportsWritten = true;
+        // Records held back for this report can be spilled now
+        if (config.archiveSpill && archiveOrder.size() > config.archiveMemoryRecords) {
+            spillArchive();
+        }
+    }
+
+    size_t getSpilledCount() {
+        lock_guard<mutex> lock(schedulerMutex);
+        return spilledRecords;
+    }
+
+    MemoryStats getMemoryStats() const {
+        return memory.getStats();
+    }
+
+    int getActiveCores() const {
+        return activeCores;
+    }
+
+    uint64_t getInstructionsRetired() const {
+        return instructionsRetired;
+    }
+
+    uint64_t getInstructionRate() const {
+        return instructionRate;
+    }
+
+    bool hasSubmissionRing() const {
+        return ring.isAttached();
+    }
+
+    uint64_t getSubmissionsAccepted() const {
+        return submissionsAccepted;
+    }
+
+    uint64_t getSubmissionsRejected() const {
+        return submissionsRejected;
+    }
+
+    ReadyQueueStats getReadyQueueStats() {
+        lock_guard<mutex> qlock(queueMutex);
+        ReadyQueueStats stats = queueStats;
+        stats.depth = readyQueue.size();
+        stats.pendingDepth = pendingReady.size();
+        return stats;
+    }
+
+    size_t getDeferredCount() {
+        lock_guard<mutex> lock(schedulerMutex);
+        return pendingAdmission.size();
+    }
+
+    // Names and pids of processes currently holding memory
+    vector<pair<int, string>> getResidentProcesses() {
+        lock_guard<mutex> lock(schedulerMutex);
+        vector<pair<int, string>> resident;
+        for (const auto& [name, it] : processIndex) {
+            if (memory.isResident(it->pid)) {
+                resident.emplace_back(it->pid, name);
+            }
+        }
+        return resident;
+    }
 
 private:
-    vector<Process> processes;
-    deque<Process*> rrQueue;
-    queue<Process*> readyQueue;
+    list<Process> processes; // list so Process* held by the queues stay valid on insert and erase
+    unordered_map<string, list<Process>::iterator> processIndex; // name -> live process, guarded by schedulerMutex
+    unordered_map<string, ProcessArchive> archiveIndex; // name -> finished process, guarded by schedulerMutex
+    deque<string> archiveOrder; // archived names, oldest first
+    size_t spilledRecords = 0;
+    bool reportsWritten = false; // once report-util has run, unreported records are not spilled
+    deque<Process*> pendingAdmission; // processes waiting for memory, guarded by schedulerMutex
+    MemoryManager memory;
+    atomic<int> activeCores{ 0 };
+    atomic<uint64_t> instructionsRetired{ 0 };
+    atomic<uint64_t> instructionRate{ 0 }; // retired during the last ~second
+    atomic<uint64_t> migratedProcesses{ 0 };
+    void (CPUScheduler::* coreLoop)(int) = nullptr; // runCore<Policy> chosen by startScheduler
+    SharedSegment segment;
+    SubmissionRing ring;
+    MetricsServer metricsServer;
+    CoreCounters coreCounters[MAX_CORES];
+    // Lock-free mirrors for the metrics endpoint
+    atomic<size_t> readyDepth{ 0 };
+    atomic<size_t> pendingReadyDepth{ 0 };
+    atomic<size_t> memoryWaitDepth{ 0 };
+    atomic<uint64_t> runningProcesses{ 0 };
+    atomic<uint64_t> createdProcesses{ 0 };
+    atomic<uint64_t> finishedProcesses{ 0 };
+    deque<CompletionEntry> pendingCompletions; // completions waiting for ring space, guarded by schedulerMutex
+    atomic<uint64_t> submissionsAccepted{ 0 };
+    atomic<uint64_t> submissionsRejected{ 0 };
+    deque<Process*> readyQueue;   // shared by FCFS and Round Robin, guarded by queueMutex
+    deque<Process*> pendingReady; // admitted processes waiting for room in readyQueue, guarded by queueMutex
+    ReadyQueueStats queueStats;   // guarded by queueMutex
     mutex queueMutex;
     vector<thread> cpuCores;
     thread schedulerThread;
     atomic<bool> isRunning;
     atomic<uint64_t> cpuCycles;
     mutex schedulerMutex;
-    int nextPid = 1000;
+    atomic<int> nextPid{ 1000 };
+
+    void populateInstructions(Process& proc) {
+        int minIns = config.minIns;
+        int maxIns = max(minIns, config.maxIns.load()); // min/max may be reloaded between the two loads
+        int numInstructions = minIns + rand() % (maxIns - minIns + 1);
+        for (int i = 0; i < numInstructions; ++i) {
+            InstructionType t = static_cast<InstructionType>(rand() % 6);
+            proc.addInstruction(Instruction(t));
+        }
+    }
+
+    void configureMemory() {
+        memory.configure(config.maxOverallMem, config.memPerFrame, config.memPerProc,
+            config.demandPaging, config.pageReplacement);
+        if (!memory.canEverFit(config.memPerProc)) {
+            cout << "[CONFIG] Warning: mem-per-proc (" << config.memPerProc
+                << ") exceeds max-overall-mem (" << config.maxOverallMem << "). No process can be admitted." << endl;
+        }
+    }
+
+    // Names are unique across live and in-memory archived processes.
+    // Caller must hold schedulerMutex
+    bool nameTaken(const string& name) const {
+        return processIndex.count(name) > 0 || archiveIndex.count(name) > 0;
+    }
+
+    // Gives the process its memory and queues it, or defers it until memory frees up.
+    // Caller must hold schedulerMutex
+    void admitProcess(Process* pPtr) {
+        createdProcesses++;
+        if (pendingAdmission.empty() && memory.allocate(pPtr->pid, config.memPerProc)) {
+            attachMemory(pPtr);
+            enqueueProcess(pPtr);
+        }
+        else {
+            pendingAdmission.push_back(pPtr);
+            memoryWaitDepth.store(pendingAdmission.size(), memory_order_relaxed);
+        }
+    }
+
+    static ProcessSnapshot snapshotOf(const ProcessArchive& record) {
+        ProcessSnapshot snap;
+        snap.name = record.name;
+        snap.pid = record.pid;
+        snap.currentInstruction = static_cast<int>(record.instructionCount);
+        snap.totalInstructions = record.instructionCount;
+        snap.isFinished = true;
+        snap.createdAt = record.createdAt;
+        snap.logSize = record.logLines;
+        snap.archived = true;
+        return snap;
+    }
+
+    // Replaces a finished process with its archive record and frees the process.
+    // Caller must hold schedulerMutex
+    void archiveProcess(Process* pPtr) {
+        auto it = processIndex.find(pPtr->name);
+        if (it == processIndex.end() || &*it->second != pPtr) {
+            return; // never erase a different process that happens to share the name
+        }
+        ProcessArchive record;
+        record.pid = pPtr->pid;
+        record.name = pPtr->name;
+        record.createdAt = pPtr->createdAt;
+        record.finishedAt = Process::getCurrentTimestamp();
+        record.instructionCount = pPtr->instructions.size();
+        {
+            lock_guard<mutex> logLock(*pPtr->logMutex);
+            record.logLines = pPtr->outputLog.size();
+        }
+        record.variables = pPtr->symbolTable.size();
+        record.lastCore = pPtr->coreId;
+
+        processes.erase(it->second);
+        processIndex.erase(it);
+        archiveOrder.push_back(record.name);
+        archiveIndex[record.name] = move(record);
+
+        if (config.archiveSpill && archiveOrder.size() > config.archiveMemoryRecords) {
+            spillArchive();
+        }
+    }
+
+    // Once reports are being written, a finished process stays in memory until a
+    // report has included it, so report-util -i never misses a spilled process.
+    // Caller must hold schedulerMutex
+    bool canSpill(const string& name) const {
+        return !reportsWritten || archiveIndex.at(name).reported;
+    }
+
+    // Appends the oldest archive records to the archive file, keeping half the
+    // in-memory limit so the file is opened once per batch rather than per process.
+    // Caller must hold schedulerMutex
+    void spillArchive() {
+        if (!canSpill(archiveOrder.front())) {
+            return; // nothing reported yet; spilled records would never reach an incremental report
+        }
+        ofstream out(config.archiveFile, ios::app);
+        if (!out.is_open()) {
+            cout << "[SCHEDULER] Could not open " << config.archiveFile << " for archiving." << endl;
+            return;
+        }
+        size_t keep = config.archiveMemoryRecords / 2;
+        while (archiveOrder.size() > keep && canSpill(archiveOrder.front())) {
+            auto it = archiveIndex.find(archiveOrder.front());
+            out << it->second.toRecord() << "\n";
+            archiveIndex.erase(it);
+            archiveOrder.pop_front();
+            spilledRecords++;
+        }
+    }
+
+    // Metrics snapshot for the metrics endpoint. Reads atomics only, so a scrape
+    // never takes schedulerMutex, queueMutex or the memory manager's mutex.
+    string renderMetrics(bool json) {
+        MemoryCounters mem = memory.getCounters();
+        uint64_t running = runningProcesses;
+        uint64_t finished = finishedProcesses;
+        uint64_t ready = readyDepth;
+        uint64_t pending = pendingReadyDepth;
+        uint64_t waitingMemory = memoryWaitDepth;
+        int cores = config.numCpu;
+
+        ostringstream out;
+        if (json) {
+            out << "{\"cpu_cycles\":" << cpuCycles
+                << ",\"instructions_retired\":" << instructionsRetired
+                << ",\"cores\":[";
+            for (int i = 0; i < cores; ++i) {
+                uint64_t busy = coreCounters[i].busyUs / 1000, idle = coreCounters[i].idleUs / 1000;
+                out << (i ? "," : "") << "{\"core\":" << i << ",\"busy_ms\":" << busy << ",\"idle_ms\":" << idle
+                    << ",\"utilization\":" << (busy + idle ? double(busy) / (busy + idle) : 0.0) << "}";
+            }
+            out << "],\"queues\":{\"ready\":" << ready << ",\"pending_ready\":" << pending
+                << ",\"waiting_memory\":" << waitingMemory << "}"
+                << ",\"processes\":{\"created\":" << createdProcesses << ",\"running\":" << running
+                << ",\"ready\":" << ready + pending << ",\"waiting_memory\":" << waitingMemory
+                << ",\"finished\":" << finished << "}"
+                << ",\"memory\":{\"used_bytes\":" << mem.usedFrames * mem.frameSize
+                << ",\"total_bytes\":" << mem.totalFrames * mem.frameSize
+                << ",\"page_faults\":" << mem.pageFaults << ",\"page_ins\":" << mem.pageIns
+                << ",\"page_outs\":" << mem.pageOuts << "}}\n";
+            return out.str();
+        }
+
+        out << "# TYPE csopesy_cpu_cycles counter\ncsopesy_cpu_cycles " << cpuCycles << "\n";
+        out << "# TYPE csopesy_instructions_retired_total counter\ncsopesy_instructions_retired_total "
+            << instructionsRetired << "\n";
+        out << "# TYPE csopesy_core_busy_ms_total counter\n";
+        for (int i = 0; i < cores; ++i) {
+            out << "csopesy_core_busy_ms_total{core=\"" << i << "\"} " << coreCounters[i].busyUs / 1000 << "\n";
+        }
+        out << "# TYPE csopesy_core_idle_ms_total counter\n";
+        for (int i = 0; i < cores; ++i) {
+            out << "csopesy_core_idle_ms_total{core=\"" << i << "\"} " << coreCounters[i].idleUs / 1000 << "\n";
+        }
+        out << "# TYPE csopesy_core_utilization gauge\n";
+        for (int i = 0; i < cores; ++i) {
+            uint64_t busy = coreCounters[i].busyUs, idle = coreCounters[i].idleUs;
+            out << "csopesy_core_utilization{core=\"" << i << "\"} " << (busy + idle ? double(busy) / (busy + idle) : 0.0) << "\n";
+        }
+        out << "# TYPE csopesy_queue_depth gauge\n";
+        out << "csopesy_queue_depth{queue=\"ready\"} " << ready << "\n";
+        out << "csopesy_queue_depth{queue=\"pending_ready\"} " << pending << "\n";
+        out << "csopesy_queue_depth{queue=\"waiting_memory\"} " << waitingMemory << "\n";
+        out << "# TYPE csopesy_processes gauge\n";
+        out << "csopesy_processes{state=\"running\"} " << running << "\n";
+        out << "csopesy_processes{state=\"ready\"} " << ready + pending << "\n";
+        out << "csopesy_processes{state=\"waiting_memory\"} " << waitingMemory << "\n";
+        out << "csopesy_processes{state=\"finished\"} " << finished << "\n";
+        out << "# TYPE csopesy_processes_created_total counter\ncsopesy_processes_created_total " << createdProcesses << "\n";
+        out << "# TYPE csopesy_memory_used_bytes gauge\ncsopesy_memory_used_bytes " << mem.usedFrames * mem.frameSize << "\n";
+        out << "# TYPE csopesy_memory_total_bytes gauge\ncsopesy_memory_total_bytes " << mem.totalFrames * mem.frameSize << "\n";
+        out << "# TYPE csopesy_page_faults_total counter\ncsopesy_page_faults_total " << mem.pageFaults << "\n";
+        out << "# TYPE csopesy_page_ins_total counter\ncsopesy_page_ins_total " << mem.pageIns << "\n";
+        out << "# TYPE csopesy_page_outs_total counter\ncsopesy_page_outs_total " << mem.pageOuts << "\n";
+        return out.str();
+    }
+
+    void openSubmissionRing() {
+        if (!config.submissionRing || ring.isAttached()) {
+            return;
+        }
+        size_t bytes = SubmissionRing::segmentSize(config.submissionRingCapacity, config.submissionRingCapacity,
+            config.submissionArenaBytes);
+        void* base = segment.create(config.submissionRingName, bytes);
+        if (base == nullptr || !ring.create(base, config.submissionRingCapacity, config.submissionRingCapacity,
+            config.submissionArenaBytes)) {
+            cout << "[CONFIG] Could not create submission ring '" << config.submissionRingName
+                << "' (capacity must be a power of two)." << endl;
+            segment.close();
+            return;
+        }
+        cout << "[CONFIG] Submission ring '" << config.submissionRingName << "' ready ("
+            << config.submissionRingCapacity << " entries)." << endl;
+    }
+
+    // Turns pending ring submissions into processes, reading descriptors and
+    // opcodes in place. When the ready queue is bounded and not deferring, only
+    // as many as fit are taken so the ring itself pushes back on the producer.
+    void consumeSubmissions() {
+        if (!ring.isAttached()) {
+            return;
+        }
+        size_t batch = config.submissionRingCapacity;
+        if (config.readyQueueCapacity > 0 && config.readyQueuePolicy != "defer") {
+            size_t queued = admissionBacklog();
+            batch = queued < config.readyQueueCapacity ? config.readyQueueCapacity - queued : 0;
+        }
+
+        lock_guard<mutex> lock(schedulerMutex);
+        while (!pendingCompletions.empty() && ring.complete(pendingCompletions.front().tag,
+            pendingCompletions.front().pid, static_cast<CompletionStatus>(pendingCompletions.front().status))) {
+            pendingCompletions.pop_front();
+        }
+        if (batch == 0) {
+            return;
+        }
+
+        ring.consume([this](const SubmissionEntry& entry, const uint8_t* opcodes, uint32_t count) {
+            int pid = nextPid++;
+            bool valid = opcodes != nullptr && count > 0; // null: entry points outside the arena
+            for (uint32_t i = 0; valid && i < count; ++i) {
+                valid = opcodes[i] <= FOR_LOOP;
+            }
+            if (!valid) {
+                submissionsRejected++;
+                notifyCompletion(entry.tag, pid, COMPLETION_REJECTED);
+                return;
+            }
+
+            string name(entry.name, strnlen(entry.name, sizeof(entry.name)));
+            if (name.empty()) name = "X" + to_string(pid);
+            if (nameTaken(name)) name += "-" + to_string(pid);
+
+            processes.emplace_back(name, pid);
+            Process* pPtr = &processes.back();
+            pPtr->instructions.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                pPtr->instructions.emplace_back(static_cast<InstructionType>(opcodes[i]));
+            }
+            pPtr->external = true;
+            pPtr->submissionTag = entry.tag;
+            processIndex[name] = prev(processes.end());
+            admitProcess(pPtr);
+            submissionsAccepted++;
+            }, batch);
+    }
+
+    // Caller must hold schedulerMutex
+    void notifyCompletion(uint64_t tag, int pid, CompletionStatus status) {
+        if (!pendingCompletions.empty() || !ring.complete(tag, pid, status)) {
+            pendingCompletions.push_back({ tag, pid, status });
+        }
+    }
+
+    void attachMemory(Process* pPtr) {
+        pPtr->attachMemory(&memory, config.memPerProc);
+    }
+
+    // Frees a finished process's memory and admits deferred processes in arrival order.
+    // Caller must hold schedulerMutex
+    void releaseProcessMemory(Process* pPtr) {
+        pPtr->detachMemory();
+        memory.release(pPtr->pid);
+        while (!pendingAdmission.empty() && memory.allocate(pendingAdmission.front()->pid, config.memPerProc)) {
+            attachMemory(pendingAdmission.front());
+            enqueueProcess(pendingAdmission.front());
+            pendingAdmission.pop_front();
+        }
+        memoryWaitDepth.store(pendingAdmission.size(), memory_order_relaxed);
+    }
+
+    bool parseConfig(Config& target) {
+        ifstream file("config.txt"); // ifstream file("../config.txt"); <- this worked for Amor but not for Gio, try to switch between these two if needed
+        if (!file.is_open()) {
+            return false;
+        }
+        string line;
+        while (getline(file, line)) {
+            istringstream iss(line);
+            string param, value;
+            if (iss >> param >> value) {
+                if (param == "num-cpu") target.numCpu = max(1, min(stoi(value), MAX_CORES));
+                else if (param == "scheduler") target.scheduler = value;
+                else if (param == "quantum-cycles") target.quantumCycles = stoi(value);
+                else if (param == "batch-process-freq") target.batchProcessFreq = stoi(value);
+                else if (param == "min-ins") target.minIns = stoi(value);
+                else if (param == "max-ins") target.maxIns = stoi(value);
+                else if (param == "delays-per-exec") target.delaysPerExec = stoi(value);
+                else if (param == "max-overall-mem") target.maxOverallMem = stoul(value);
+                else if (param == "mem-per-frame") target.memPerFrame = stoul(value);
+                else if (param == "mem-per-proc") target.memPerProc = stoul(value);
+                else if (param == "demand-paging") target.demandPaging = (value == "on" || value == "1");
+                else if (param == "page-replacement") target.pageReplacement = value;
+                else if (param == "archive-spill") target.archiveSpill = (value == "on" || value == "1");
+                else if (param == "archive-file") target.archiveFile = value;
+                else if (param == "archive-memory-records") target.archiveMemoryRecords = stoul(value);
+                else if (param == "ready-queue-capacity") target.readyQueueCapacity = stoul(value);
+                else if (param == "ready-queue-policy") target.readyQueuePolicy = value;
+                else if (param == "lockstep-lanes") target.lockstepLanes = stoul(value);
+                else if (param == "submission-ring") target.submissionRing = (value == "on" || value == "1");
+                else if (param == "submission-ring-name") target.submissionRingName = value;
+                else if (param == "submission-ring-capacity") target.submissionRingCapacity = stoul(value);
+                else if (param == "submission-arena-bytes") target.submissionArenaBytes = stoull(value);
+                else if (param == "metrics") target.metrics = (value == "on" || value == "1");
+                else if (param == "metrics-socket") target.metricsSocket = value;
+                else if (param == "report-compress") target.reportCompress = (value == "on" || value == "1");
+                else if (param == "report-workers") target.reportWorkers = stoul(value);
+            }
+        }
+        file.close();
+        return true;
+    }
+
+    // Grows or shrinks the running core pool. Cores past the new count finish
+    // the instruction they are on, hand their process back to the front of the
+    // ready queue and exit; the call waits for them so the cost can be reported.
+    void resizeCores(int newCount) {
+        int oldCount = config.numCpu;
+        config.numCpu = newCount;
+        if (!isRunning || newCount == oldCount) {
+            return;
+        }
+
+        auto start = chrono::steady_clock::now();
+        uint64_t migratedBefore = migratedProcesses;
+        if (newCount > oldCount) {
+            for (int i = oldCount; i < newCount; ++i) {
+                cpuCores.emplace_back(coreLoop, this, i);
+            }
+        }
+        else {
+            for (int i = newCount; i < oldCount; ++i) {
+                if (cpuCores[i].joinable()) {
+                    cpuCores[i].join();
+                }
+            }
+            cpuCores.resize(newCount);
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "[SCHEDULER] Cores " << oldCount << " -> " << newCount << " in " << ms << " ms ("
+            << (migratedProcesses - migratedBefore) << " processes migrated)" << endl;
+    }
+
+    // Core loop. The policy is a template parameter, so the per-process
+    // FCFS/Round Robin choice is resolved at compile time.
+    template <typename Policy>
+    void runCore(int core) {
+        CoreCounters& counters = coreCounters[core];
+        auto mark = chrono::steady_clock::now();
+        while (isRunning && core < config.numCpu) {
+            Process* currentProcess = dequeueProcess();
+
+            if (currentProcess == nullptr) {
+                this_thread::sleep_for(chrono::milliseconds(100));
+                CoreCounters::accumulate(counters.idleUs, mark);
+                continue;
+            }
+            currentProcess->coreId = core;
+            activeCores++;
+
+            if constexpr (!Policy::preemptive) {
+                // FCFS
+                cout << "[CPU " << core << "] Executing process: "
+                    << currentProcess->name << endl;
+            }
+            else {
+                currentProcess->quantumLeft = config.quantumCycles;
+            }
+
+            // Round Robin runs for one quantum, then goes to the back of the ready queue
+            bool finished = false;
+            bool draining = false;
+            while (!currentProcess->isFinished) {
+                if (core >= config.numCpu) {
+                    // This core was removed by reload-config
+                    draining = true;
+                    break;
+                }
+                if constexpr (Policy::preemptive) {
+                    if (!isRunning || currentProcess->quantumLeft <= 0) {
+                        break;
+                    }
+                }
+                StepResult step = currentProcess->executeNextInstruction(config.delaysPerExec);
+                if (step == STEP_FINISHED) {
+                    finished = true;
+                    break;
+                }
+                if (step == STEP_EXECUTED) {
+                    instructionsRetired++; // sleep ticks don't retire anything
+                }
+                if constexpr (Policy::preemptive) {
+                    currentProcess->quantumLeft--;
+                }
+                this_thread::sleep_for(chrono::milliseconds(1));
+                CoreCounters::accumulate(counters.busyUs, mark);
+            }
+
+            if (finished) {
+                finishProcess(currentProcess, core);
+            }
+            else {
+                currentProcess->coreId = -1;
+                requeueProcess(currentProcess, draining);
+                if (draining) migratedProcesses++;
+            }
+            CoreCounters::accumulate(counters.busyUs, mark);
+            activeCores--;
+        }
+    }
+
+    // Lockstep core loop: the core holds up to lockstepLanes processes and every
+    // step runs one instruction of each. ADD/SUBTRACT operands are resolved per
+    // process into structure-of-arrays buffers, then all lanes with the same
+    // opcode are computed together by the SIMD kernels in simd.h.
+    template <typename Policy>
+    void runLockstepCore(int core) {
+        const size_t laneCount = config.lockstepLanes;
+        vector<Process*> lanes;
+        vector<Process*> addLanesOf, subLanesOf;
+        vector<string> addDest, subDest;
+        vector<uint16_t> addLhs, addRhs, addOut, subLhs, subRhs, subOut;
+        bool active = false;
+        CoreCounters& counters = coreCounters[core];
+        auto mark = chrono::steady_clock::now();
+
+        while (isRunning && core < config.numCpu) {
+            while (lanes.size() < laneCount) {
+                Process* pPtr = dequeueProcess();
+                if (pPtr == nullptr) {
+                    break;
+                }
+                pPtr->coreId = core;
+                if constexpr (Policy::preemptive) {
+                    pPtr->quantumLeft = config.quantumCycles;
+                }
+                lanes.push_back(pPtr);
+            }
+
+            if (lanes.empty()) {
+                if (active) {
+                    activeCores--;
+                    active = false;
+                }
+                this_thread::sleep_for(chrono::milliseconds(100));
+                CoreCounters::accumulate(counters.idleUs, mark);
+                continue;
+            }
+            if (!active) {
+                activeCores++;
+                active = true;
+            }
+
+            addLanesOf.clear(); addDest.clear(); addLhs.clear(); addRhs.clear();
+            subLanesOf.clear(); subDest.clear(); subLhs.clear(); subRhs.clear();
+            int delays = config.delaysPerExec;
+            uint64_t retired = 0;
+            for (Process* pPtr : lanes) {
+                Instruction* next = pPtr->peekNextInstruction();
+                if (next != nullptr && next->getType() == ADD) {
+                    ArithmeticOperands ops = Instruction::prepareArithmetic(*pPtr);
+                    addLanesOf.push_back(pPtr);
+                    addDest.push_back(move(ops.dest));
+                    addLhs.push_back(ops.lhs);
+                    addRhs.push_back(ops.rhs);
+                }
+                else if (next != nullptr && next->getType() == SUBTRACT) {
+                    ArithmeticOperands ops = Instruction::prepareArithmetic(*pPtr);
+                    subLanesOf.push_back(pPtr);
+                    subDest.push_back(move(ops.dest));
+                    subLhs.push_back(ops.lhs);
+                    subRhs.push_back(ops.rhs);
+                }
+                else if (pPtr->executeNextInstruction(delays) == STEP_EXECUTED) {
+                    retired++; // sleeping lanes and the final finishing step retire nothing
+                }
+            }
+
+            addOut.resize(addLhs.size());
+            addLanes(addLhs.data(), addRhs.data(), addOut.data(), addOut.size());
+            for (size_t i = 0; i < addLanesOf.size(); ++i) {
+                addLanesOf[i]->setSymbol(addDest[i], addOut[i]);
+                addLanesOf[i]->retireInstruction(delays);
+            }
+            subOut.resize(subLhs.size());
+            subtractLanes(subLhs.data(), subRhs.data(), subOut.data(), subOut.size());
+            for (size_t i = 0; i < subLanesOf.size(); ++i) {
+                subLanesOf[i]->setSymbol(subDest[i], subOut[i]);
+                subLanesOf[i]->retireInstruction(delays);
+            }
+            instructionsRetired += retired + addLanesOf.size() + subLanesOf.size();
+
+            // Retire finished lanes and, for Round Robin, lanes whose quantum ran out
+            for (size_t i = 0; i < lanes.size();) {
+                Process* pPtr = lanes[i];
+                bool preempted = false;
+                if constexpr (Policy::preemptive) {
+                    pPtr->quantumLeft--;
+                    preempted = pPtr->quantumLeft <= 0;
+                }
+                if (pPtr->isFinished) {
+                    finishProcess(pPtr, core);
+                }
+                else if (preempted) {
+                    pPtr->coreId = -1;
+                    requeueProcess(pPtr);
+                }
+                else {
+                    ++i;
+                    continue;
+                }
+                lanes[i] = lanes.back();
+                lanes.pop_back();
+            }
+
+            this_thread::sleep_for(chrono::milliseconds(1));
+            CoreCounters::accumulate(counters.busyUs, mark);
+        }
+
+        // Stopped or removed by reload-config: hand the lanes back to the ready queue
+        bool draining = core >= config.numCpu;
+        for (Process* pPtr : lanes) {
+            pPtr->coreId = -1;
+            requeueProcess(pPtr, true);
+            if (draining) migratedProcesses++;
+        }
+        if (active) {
+            activeCores--;
+        }
+    }
+
+    // Caller must hold queueMutex
+    bool readyQueueFullLocked() const {
+        return config.readyQueueCapacity > 0 && readyQueue.size() >= config.readyQueueCapacity;
+    }
+
+    // Processes generated but not yet running: the ready queue, admitted processes
+    // waiting for room in it, and processes waiting for memory. Counting all three
+    // keeps the backlog bounded when memory, not the queue, is the bottleneck.
+    size_t admissionBacklog() {
+        lock_guard<mutex> qlock(queueMutex);
+        return readyQueue.size() + pendingReady.size() + memoryWaitDepth.load(memory_order_relaxed);
+    }
+
+    bool isAdmissionBacklogFull() {
+        return config.readyQueueCapacity > 0 && admissionBacklog() >= config.readyQueueCapacity;
+    }
+
+    // Caller must hold queueMutex
+    void pushReady(Process* pPtr) {
+        pPtr->enqueuedAt = chrono::steady_clock::now();
+        readyQueue.push_back(pPtr);
+        queueStats.peakDepth = max(queueStats.peakDepth, readyQueue.size());
+        publishQueueDepths();
+    }
+
+    // Mirrors the queue sizes into atomics so metrics never take queueMutex.
+    // Caller must hold queueMutex
+    void publishQueueDepths() {
+        readyDepth.store(readyQueue.size(), memory_order_relaxed);
+        pendingReadyDepth.store(pendingReady.size(), memory_order_relaxed);
+    }
+
+    // Puts a newly admitted process on the ready queue, or on the pending list if the
+    // queue is full (an admitted process already holds memory, so it is never dropped).
+    // Caller must hold schedulerMutex
+    void enqueueProcess(Process* pPtr) {
+        lock_guard<mutex> qlock(queueMutex);
+        queueStats.admitted++;
+        if (readyQueueFullLocked()) {
+            pendingReady.push_back(pPtr);
+            publishQueueDepths();
+        }
+        else {
+            pushReady(pPtr);
+        }
+    }
+
+    // A preempted process goes back to the end of the ready queue, a migrated one
+    // to the front. It is already admitted, so the capacity does not apply to it.
+    void requeueProcess(Process* pPtr, bool front = false) {
+        runningProcesses--;
+        lock_guard<mutex> qlock(queueMutex);
+        if (front) {
+            pPtr->enqueuedAt = chrono::steady_clock::now();
+            readyQueue.push_front(pPtr);
+            queueStats.peakDepth = max(queueStats.peakDepth, readyQueue.size());
+            publishQueueDepths();
+        }
+        else {
+            pushReady(pPtr);
+        }
+    }
+
+    // Takes the next process off the ready queue and refills it from the pending list.
+    Process* dequeueProcess() {
+        lock_guard<mutex> qlock(queueMutex);
+        if (readyQueue.empty()) {
+            return nullptr;
+        }
+        Process* pPtr = readyQueue.front();
+        readyQueue.pop_front();
+
+        double waitMs = chrono::duration<double, milli>(chrono::steady_clock::now() - pPtr->enqueuedAt).count();
+        queueStats.dispatched++;
+        queueStats.totalWaitMs += waitMs;
+        queueStats.maxWaitMs = max(queueStats.maxWaitMs, waitMs);
+
+        while (!pendingReady.empty() && !readyQueueFullLocked()) {
+            pushReady(pendingReady.front());
+            pendingReady.pop_front();
+        }
+        publishQueueDepths();
+        runningProcesses++;
+        return pPtr;
+    }
+
+    void finishProcess(Process* pPtr, int core) {
+        runningProcesses--;
+        finishedProcesses++;
+        lock_guard<mutex> lock(schedulerMutex);
+        releaseProcessMemory(pPtr);
+        cout << "[CPU " << core << "] Process "
+            << pPtr->name << " finished execution" << endl;
+        if (pPtr->external) {
+            notifyCompletion(pPtr->submissionTag, pPtr->pid, COMPLETION_FINISHED);
+        }
+        archiveProcess(pPtr);
+    }
 
     // Optionally, move these into CPUScheduler if you use them
     vector<string> finishedScreens;
@@ -0,0 +1,54 @@
+/**
+ * @file simd.h
+ * @brief This file contains the lane-wise uint16_t kernels used by lockstep execution
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CSOPESY_SIMD_NAME "AVX2"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSOPESY_SIMD_SSE2
+#define CSOPESY_SIMD_NAME "SSE2"
+#else
+#define CSOPESY_SIMD_NAME "scalar"
+#endif
+
+// out[i] = a[i] + b[i] (or a[i] - b[i]) for n lanes stored as structure-of-arrays.
+// Results wrap around exactly like the scalar uint16_t code in Instruction::execute.
+// AVX2 handles 16 lanes per instruction, SSE2 8, the rest falls back to scalar.
+template <bool Subtract>
+inline void applyLanes(const uint16_t* a, const uint16_t* b, uint16_t* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i vr = Subtract ? _mm256_sub_epi16(va, vb) : _mm256_add_epi16(va, vb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), vr);
+    }
+#endif
+#if defined(__AVX2__) || defined(CSOPESY_SIMD_SSE2)
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i vr = Subtract ? _mm_sub_epi16(va, vb) : _mm_add_epi16(va, vb);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), vr);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = Subtract ? static_cast<uint16_t>(a[i] - b[i]) : static_cast<uint16_t>(a[i] + b[i]);
+    }
+}
+
+inline void addLanes(const uint16_t* a, const uint16_t* b, uint16_t* out, size_t n) {
+    applyLanes<false>(a, b, out, n);
+}
+
+inline void subtractLanes(const uint16_t* a, const uint16_t* b, uint16_t* out, size_t n) {
+    applyLanes<true>(a, b, out, n);
+}
@@ -0,0 +1,273 @@
+/**
+ * @file submission.h
+ * @brief This file contains the shared-memory submission ring used to inject processes from other programs
+ *
+ * Segment layout (all offsets from the start of the mapping):
+ *   SubmissionHeader | SubmissionEntry[submissionCapacity] | CompletionEntry[completionCapacity] | opcode arena
+ *
+ * One producer program writes a process's opcodes (one byte per InstructionType) into
+ * the arena and publishes a SubmissionEntry; the scheduler copies both out and checks
+ * them against the published arena range before using them. When an
+ * injected process finishes, the scheduler publishes a CompletionEntry carrying the
+ * producer's tag. Both rings are single-producer/single-consumer and lock-free; the
+ * indices are free-running counters, capacities must be powers of two.
+ */
+
+#pragma once
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <new>
+
+using namespace std;
+
+/* ========== SEGMENT LAYOUT ========== */
+const uint32_t SUBMISSION_MAGIC = 0x43535350; // "CSSP"
+const uint32_t SUBMISSION_VERSION = 1;
+
+enum CompletionStatus : uint32_t {
+    COMPLETION_FINISHED = 0,
+    COMPLETION_REJECTED = 1 // empty stream, unknown opcode or entry outside the arena
+};
+
+struct SubmissionEntry {
+    uint64_t tag;              // chosen by the producer, echoed in the completion
+    uint64_t arenaOffset;      // free-running byte offset of the opcodes in the arena
+    uint32_t instructionCount;
+    char name[36];             // optional, NUL-terminated; empty = scheduler picks one
+};
+
+struct CompletionEntry {
+    uint64_t tag;
+    int32_t pid;
+    uint32_t status;           // CompletionStatus
+};
+
+struct SubmissionHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t submissionCapacity;
+    uint32_t completionCapacity;
+    uint64_t arenaBytes;
+    // Each counter sits on its own cache line so producer and consumer don't false-share
+    alignas(64) atomic<uint64_t> submissionTail; // written by the producer
+    alignas(64) atomic<uint64_t> arenaTail;      // written by the producer
+    alignas(64) atomic<uint64_t> submissionHead; // written by the scheduler
+    alignas(64) atomic<uint64_t> arenaHead;      // written by the scheduler
+    alignas(64) atomic<uint64_t> completionTail; // written by the scheduler
+    alignas(64) atomic<uint64_t> completionHead; // written by the producer
+};
+
+static_assert(atomic<uint64_t>::is_always_lock_free, "ring counters must be lock-free to be shared between processes");
+
+/* ========== SUBMISSION RING ========== */
+// View over a segment. The scheduler uses consume()/complete(); external
+// programs include this header and use submit()/pollCompletion().
+class SubmissionRing {
+public:
+    static size_t segmentSize(uint32_t submissionCapacity, uint32_t completionCapacity, uint64_t arenaBytes) {
+        return sizeof(SubmissionHeader) + submissionCapacity * sizeof(SubmissionEntry)
+            + completionCapacity * sizeof(CompletionEntry) + arenaBytes;
+    }
+
+    // Lays out a fresh segment (creator side)
+    bool create(void* base, uint32_t submissionCapacity, uint32_t completionCapacity, uint64_t arenaBytes) {
+        if (!isPowerOfTwo(submissionCapacity) || !isPowerOfTwo(completionCapacity) || arenaBytes == 0) {
+            return false;
+        }
+        header = new (base) SubmissionHeader();
+        header->magic = SUBMISSION_MAGIC;
+        header->version = SUBMISSION_VERSION;
+        header->submissionCapacity = submissionCapacity;
+        header->completionCapacity = completionCapacity;
+        header->arenaBytes = arenaBytes;
+        return attach(base);
+    }
+
+    // Uses a segment laid out by create() (possibly in another process)
+    bool attach(void* base) {
+        SubmissionHeader* h = static_cast<SubmissionHeader*>(base);
+        if (h->magic != SUBMISSION_MAGIC || h->version != SUBMISSION_VERSION) {
+            return false;
+        }
+        header = h;
+        uint8_t* cursor = static_cast<uint8_t*>(base) + sizeof(SubmissionHeader);
+        submissions = reinterpret_cast<SubmissionEntry*>(cursor);
+        cursor += h->submissionCapacity * sizeof(SubmissionEntry);
+        completions = reinterpret_cast<CompletionEntry*>(cursor);
+        cursor += h->completionCapacity * sizeof(CompletionEntry);
+        arena = cursor;
+        return true;
+    }
+
+    bool isAttached() const {
+        return header != nullptr;
+    }
+
+    /* ----- producer side ----- */
+
+    // Copies the opcodes into the arena and publishes the entry. Returns false if
+    // the ring or the arena is full (retry after the scheduler catches up).
+    bool submit(const uint8_t* opcodes, uint32_t count, uint64_t tag, const char* name = "") {
+        uint64_t tail = header->submissionTail.load(memory_order_relaxed);
+        if (tail - header->submissionHead.load(memory_order_acquire) >= header->submissionCapacity) {
+            return false;
+        }
+        uint64_t offset;
+        if (!reserveArena(count, offset)) {
+            return false;
+        }
+        memcpy(arena + offset % header->arenaBytes, opcodes, count);
+
+        SubmissionEntry& entry = submissions[tail & (header->submissionCapacity - 1)];
+        entry.tag = tag;
+        entry.arenaOffset = offset;
+        entry.instructionCount = count;
+        size_t length = 0;
+        while (name[length] != '\0' && length < sizeof(entry.name) - 1) {
+            entry.name[length] = name[length];
+            length++;
+        }
+        entry.name[length] = '\0';
+
+        header->arenaTail.store(offset + count, memory_order_relaxed);
+        header->submissionTail.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+    bool pollCompletion(CompletionEntry& out) {
+        uint64_t head = header->completionHead.load(memory_order_relaxed);
+        if (head == header->completionTail.load(memory_order_acquire)) {
+            return false;
+        }
+        out = completions[head & (header->completionCapacity - 1)];
+        header->completionHead.store(head + 1, memory_order_release);
+        return true;
+    }
+
+    /* ----- scheduler side ----- */
+
+    // Calls handler(entry, opcodes, count) for up to maxBatch pending submissions,
+    // then releases their slots and arena bytes. The producer is another program,
+    // so each entry and its opcodes are copied out of the segment once and the
+    // entry is bounds-checked against the published arena range first; an entry
+    // pointing outside it is passed with opcodes == nullptr and its bytes are not
+    // released (its offset can't be trusted).
+    template <typename Handler>
+    size_t consume(Handler&& handler, size_t maxBatch) {
+        uint64_t head = header->submissionHead.load(memory_order_relaxed);
+        uint64_t tail = header->submissionTail.load(memory_order_acquire);
+        uint64_t arenaTail = header->arenaTail.load(memory_order_acquire);
+        uint64_t arenaBytes = header->arenaBytes;
+        size_t consumed = 0;
+        uint64_t arenaEnd = header->arenaHead.load(memory_order_relaxed);
+        while (head != tail && consumed < maxBatch) {
+            SubmissionEntry entry = submissions[head & (header->submissionCapacity - 1)];
+            uint64_t offset = entry.arenaOffset;
+            uint32_t count = entry.instructionCount;
+            bool inBounds = offset >= arenaEnd && offset <= arenaTail && count <= arenaTail - offset
+                && count <= arenaBytes - offset % arenaBytes;
+            if (inBounds) {
+                scratch.assign(arena + offset % arenaBytes, arena + offset % arenaBytes + count);
+                handler(entry, scratch.data(), count);
+                arenaEnd = offset + count;
+            }
+            else {
+                handler(entry, static_cast<const uint8_t*>(nullptr), 0u);
+            }
+            head++;
+            consumed++;
+        }
+        if (consumed > 0) {
+            header->arenaHead.store(arenaEnd, memory_order_release);
+            header->submissionHead.store(head, memory_order_release);
+        }
+        return consumed;
+    }
+
+    // Returns false if the completion ring is full (the producer isn't polling)
+    bool complete(uint64_t tag, int pid, CompletionStatus status) {
+        uint64_t tail = header->completionTail.load(memory_order_relaxed);
+        if (tail - header->completionHead.load(memory_order_acquire) >= header->completionCapacity) {
+            return false;
+        }
+        CompletionEntry& entry = completions[tail & (header->completionCapacity - 1)];
+        entry.tag = tag;
+        entry.pid = pid;
+        entry.status = status;
+        header->completionTail.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+private:
+    static bool isPowerOfTwo(uint32_t value) {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    // Finds `count` contiguous arena bytes, skipping the end of the arena if the
+    // stream would wrap around. Producer side only.
+    bool reserveArena(uint32_t count, uint64_t& offset) {
+        uint64_t size = header->arenaBytes;
+        if (count > size) {
+            return false;
+        }
+        offset = header->arenaTail.load(memory_order_relaxed);
+        uint64_t inArena = offset % size;
+        if (inArena + count > size) {
+            offset += size - inArena;
+        }
+        return offset + count - header->arenaHead.load(memory_order_acquire) <= size;
+    }
+
+    SubmissionHeader* header = nullptr;
+    SubmissionEntry* submissions = nullptr;
+    CompletionEntry* completions = nullptr;
+    uint8_t* arena = nullptr;
+    vector<uint8_t> scratch; // scheduler-side copy of the opcodes being consumed
+};
+
+/* ========== SHARED SEGMENT ========== */
+// Named, pagefile-backed file mapping that other local programs open with
+// OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name) and SubmissionRing::attach().
+class SharedSegment {
+public:
+    ~SharedSegment() {
+        close();
+    }
+
+    void* create(const string& name, size_t bytes) {
+        close();
+        uint64_t size = bytes;
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+            static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), name.c_str());
+        if (mapping == NULL) {
+            return nullptr;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+        if (view == nullptr) {
+            close();
+        }
+        return view;
+    }
+
+    void close() {
+        if (view != nullptr) {
+            UnmapViewOfFile(view);
+            view = nullptr;
+        }
+        if (mapping != NULL) {
+            CloseHandle(mapping);
+            mapping = NULL;
+        }
+    }
+
+private:
+    HANDLE mapping = NULL;
+    void* view = nullptr;
+};